@@ -16,8 +16,6 @@
 #include "rlImGuiColors.h"
 #include "raylib.h"
 
-extern ImFont* IconFont;
-
 ViewableItem* ListItemView::Show(ViewableItemContainer& container)
 {
     ViewableItem* item = container.Reset();
@@ -23,8 +23,6 @@
 #include <limits>
 
 
-ImFont* IconFont = nullptr;
-
 int main(int argc, char* argv[])
 {
 	// Initialization
@@ -56,9 +54,6 @@ int main(int argc, char* argv[])
     ImGuiIO& io = ImGui::GetIO();
     io.Fonts->AddFontFromMemoryCompressedTTF((void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, 12, &icons_config, icons_ranges);
 
-    icons_config.MergeMode = false;
-    IconFont = io.Fonts->AddFontFromMemoryCompressedTTF((void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, 72, &icons_config, icons_ranges);
-
     rlImGuiEndInitImGui();
 
 	AssetBrowserPanel assetBrowser;
@@ -0,0 +1,126 @@
+/*******************************************************************************************
+*
+*   raylib-extras [ImGui] example - Render benchmark
+*
+*	Builds a very large ImGui frame (a dense scatter plot and a text heavy log)
+*	and measures the CPU time spent submitting it with each rlImGui render mode
+*
+*   Copyright (c) 2024 Jeffery Myers
+*
+********************************************************************************************/
+
+#include "raylib.h"
+#include "raymath.h"
+
+#include "imgui.h"
+#include "rlImGui.h"
+
+static const char* RenderModeNames[] = { "Immediate", "Retained", "Streamed" };
+
+int main(int argc, char* argv[])
+{
+	// Initialization
+	//--------------------------------------------------------------------------------------
+	int screenWidth = 1600;
+	int screenHeight = 900;
+
+	SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+	InitWindow(screenWidth, screenHeight, "raylib-Extras [ImGui] example - render benchmark");
+	rlImGuiSetup(true);
+
+	int renderMode = RLIMGUI_RENDER_IMMEDIATE;
+	int pointCount = 50000;
+	int logLines = 2000;
+
+	bool frameCaching = false;
+	bool previousFrameCaching = false;
+	bool windowLayers = false;
+	int frameLatency = 0;
+	float resolutionScale = 1.0f;
+	float sharpening = 0.0f;
+
+	double renderTime = 0;
+
+	// Main game loop
+	while (!WindowShouldClose())    // Detect window close button or ESC key
+	{
+		BeginDrawing();
+		ClearBackground(DARKGRAY);
+
+		rlImGuiBegin();
+
+		rlImGuiRenderStats stats = rlImGuiGetRenderStats();
+
+		if (ImGui::Begin("Benchmark"))
+		{
+			ImGui::Combo("Render mode", &renderMode, RenderModeNames, IM_ARRAYSIZE(RenderModeNames));
+			ImGui::SliderInt("Points", &pointCount, 1000, 200000);
+			ImGui::SliderInt("Log lines", &logLines, 100, 10000);
+			ImGui::Checkbox("Frame cache", &frameCaching);
+			ImGui::Checkbox("Window layers", &windowLayers);
+			ImGui::SliderInt("Frame latency", &frameLatency, 0, 1);
+			ImGui::SliderFloat("Resolution scale", &resolutionScale, 0.25f, 1.0f);
+			ImGui::SliderFloat("Sharpening", &sharpening, 0.0f, 1.0f);
+
+			ImGui::Separator();
+			ImGui::Text("Submit time %.3f ms (average)", renderTime * 1000.0);
+			ImGui::Text("Build %.3f ms, render %.3f ms, latency %d", stats.BuildMilliseconds, stats.RenderMilliseconds, stats.FrameLatency);
+			ImGui::Text("Resolution scale %.2f", stats.ResolutionScale);
+			ImGui::Text("Stream kernel %s", rlImGuiGetStreamKernelName());
+			ImGui::Text("Draw lists %d, vertices %d, indices %d", stats.DrawLists, stats.Vertices, stats.Indices);
+			ImGui::Text("Commands %d, submissions %d, culled %d", stats.Commands, stats.Submissions, stats.CulledCommands);
+			ImGui::Text("State changes applied %d, skipped %d", stats.StateChangesApplied, stats.StateChangesSkipped);
+			ImGui::Text("Batch capacity %d, high water %d", stats.BatchCapacity, stats.BatchHighWater);
+			ImGui::Text("Frame cache hit rate %.1f%%", rlImGuiGetFrameCacheHitRate() * 100.0f);
+			ImGui::Text("Window layers drawn %d, updated %d", stats.WindowLayersDrawn, stats.WindowLayersUpdated);
+		}
+		ImGui::End();
+
+		if (ImGui::Begin("Scatter"))
+		{
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			ImVec2 size = ImGui::GetContentRegionAvail();
+
+			for (int i = 0; i < pointCount; i++)
+			{
+				float t = i * 0.618034f;
+				float x = origin.x + (t - floorf(t)) * size.x;
+				float y = origin.y + (0.5f + 0.45f * sinf(i * 0.001f + (float)GetTime())) * size.y;
+				drawList->AddRectFilled(ImVec2(x, y), ImVec2(x + 2, y + 2), IM_COL32(255, 200 - (i % 200), i % 255, 255));
+			}
+		}
+		ImGui::End();
+
+		if (ImGui::Begin("Log"))
+		{
+			for (int i = 0; i < logLines; i++)
+				ImGui::Text("%05d  the quick brown fox jumps over the lazy dog %f", i, GetTime());
+		}
+		ImGui::End();
+
+		rlImGuiSetRenderMode((rlImGuiRenderMode)renderMode);
+		if (frameCaching != previousFrameCaching)
+			rlImGuiSetFrameCaching(frameCaching);
+		previousFrameCaching = frameCaching;
+		rlImGuiSetWindowLayers(windowLayers);
+		rlImGuiSetFrameLatency(frameLatency);
+		rlImGuiSetResolutionScale(resolutionScale);
+		rlImGuiSetResolutionSharpening(sharpening);
+
+		double start = GetTime();
+		rlImGuiEnd();
+		renderTime = renderTime * 0.95 + (GetTime() - start) * 0.05;
+
+		EndDrawing();
+		//----------------------------------------------------------------------------------
+	}
+	rlImGuiShutdown();
+
+	// De-Initialization
+	//--------------------------------------------------------------------------------------
+	CloseWindow();        // Close window and OpenGL context
+	//--------------------------------------------------------------------------------------
+
+	return 0;
+}
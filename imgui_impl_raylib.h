@@ -48,6 +48,7 @@
 #ifndef IMGUI_DISABLE
 CIMGUI_API bool ImGui_ImplRaylib_Init(void);
 CIMGUI_API void ImGui_ImplRaylib_BuildFontAtlas(void);
+CIMGUI_API bool ImGui_ImplRaylib_BuildFontAtlasAsync(void (*setup)(ImFontAtlas* atlas, void* userData), void* userData);   // builds a new atlas on a worker thread, swapped into io.Fonts by ImGui_ImplRaylib_NewFrame when ready
 CIMGUI_API void ImGui_ImplRaylib_Shutdown(void);
 CIMGUI_API void ImGui_ImplRaylib_NewFrame(void);
 CIMGUI_API void ImGui_ImplRaylib_RenderDrawData(ImDrawData* draw_data);
@@ -12,6 +12,19 @@ newoption
 	default = "opengl33"
 }
 
+newoption
+{
+	trigger = "imdrawidx32",
+	description = "Build ImGui with 32 bit draw indices (ImDrawIdx=unsigned int) so huge draw lists use fewer commands"
+}
+
+newoption
+{
+	trigger = "fa-subset",
+	value = "DIRS",
+	description = "Only load the Font Awesome icons used in the sources under DIRS (separated by ;), scanned when the project files are generated"
+}
+
 function define_C()
 	language "C"
 end
@@ -66,6 +79,50 @@ function check_imgui()
 	end
 end
 
+-- writes extras/FontAwesomeSubset.h with the codepoints of every ICON_FA_ macro used in the sources under dirs
+function generate_font_awesome_subset(dirs)
+	local codepoints = {}
+	for line in io.lines("extras/IconsFontAwesome6.h") do
+		local name, codepoint = line:match("^#define (ICON_FA_[%w_]+) .-// U%+(%x+)")
+		if name then
+			codepoints[name] = tonumber(codepoint, 16)
+		end
+	end
+
+	local used = {}
+	for dir in string.gmatch(dirs, "[^;]+") do
+		for _, pattern in ipairs({ "/**.c", "/**.cpp", "/**.h", "/**.hpp" }) do
+			for _, file in ipairs(os.matchfiles(dir .. pattern)) do
+				if path.getname(file) ~= "IconsFontAwesome6.h" and path.getname(file) ~= "FontAwesomeSubset.h" then
+					for name in io.readfile(file):gmatch("ICON_FA_[%w_]+") do
+						if codepoints[name] then
+							used[codepoints[name]] = true
+						end
+					end
+				end
+			end
+		end
+	end
+
+	local list = {}
+	for codepoint in pairs(used) do
+		table.insert(list, string.format("0x%04x", codepoint))
+	end
+	table.sort(list)
+
+	local lines = {
+		"// Generated by premake5 --fa-subset=" .. dirs .. ", do not edit",
+		"// the Font Awesome icons used by the application, rlImGui only loads these when RLIMGUI_FONT_AWESOME_SUBSET is defined",
+		"#pragma once",
+		"",
+		"#define FONT_AWESOME_SUBSET_COUNT " .. #list,
+		"static const int FontAwesomeSubsetCodepoints[] = { " .. ((#list > 0) and table.concat(list, ", ") or "0") .. " };",
+		"",
+	}
+	io.writefile("extras/FontAwesomeSubset.h", table.concat(lines, "\n"))
+	print("Font Awesome subset: " .. #list .. " icons")
+end
+
 workspace "rlImGui"
 	configurations { "Debug", "Release" }
 	platforms { "x64"}
@@ -79,6 +136,12 @@ workspace "rlImGui"
 		defines { "NDEBUG" }
 		optimize "On"	
 		
+	filter { "options:imdrawidx32" }
+		defines { "ImDrawIdx=unsigned int" }
+
+	filter { "options:fa-subset" }
+		defines { "RLIMGUI_FONT_AWESOME_SUBSET" }
+
 	filter { "platforms:x64" }
 		architecture "x86_64"
 
@@ -94,6 +157,10 @@ workspace "rlImGui"
 	check_raylib()
 	check_imgui()
 
+	if _OPTIONS["fa-subset"] then
+		generate_font_awesome_subset(_OPTIONS["fa-subset"])
+	end
+
 	include ("raylib_premake5.lua")
 		
 project "rlImGui"
@@ -203,6 +270,27 @@ project "docking_example"
     filter "action:vs*"
 		debugdir "$(SolutionDir)"
 
+project "render_benchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cdialect "C99"
+	cppdialect "C++17"
+	location "build"
+	targetdir "bin/%{cfg.buildcfg}"
+	
+	vpaths 
+	{
+		["Header Files"] = { "examples/**.h"},
+		["Source Files"] = {"examples/**.cpp", "examples/**.c"},
+	}
+	files {"examples/render_benchmark.cpp"}
+	link_raylib()
+	links {"rlImGui"}
+	includedirs {"./", "imgui", "imgui-master" }
+		
+    filter "action:vs*"
+		debugdir "$(SolutionDir)"
+
 project "asset_browser"
 	kind "ConsoleApp"
 	language "C++"
@@ -32,23 +32,100 @@
 #include "imgui_impl_raylib.h"
 
 #include "raylib.h"
+#include "raymath.h"
 #include "rlgl.h"
 
+#include <float.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
+// font files are mapped with the Win32 API. Its GDI and USER parts declare Rectangle, CloseWindow, DrawText and
+// other names raylib uses, so they are left out, the same way raylib includes windows.h itself
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOGDI
+#define NOGDI
+#endif
+#ifndef NOUSER
+#define NOUSER
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifndef NO_FONT_AWESOME
 #include "extras/FA6FreeSolidFontData.h"
+// written by premake5 --fa-subset, the icons the application sources use
+#if defined(RLIMGUI_FONT_AWESOME_SUBSET)
+#include "extras/FontAwesomeSubset.h"
+#endif
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define RLIMGUI_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RLIMGUI_SSE2
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+#define RLIMGUI_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define RLIMGUI_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define RLIMGUI_NEON
+#include <arm_neon.h>
+#endif
+
+// font atlases can be built on a worker thread, web builds without pthreads build them on the main thread instead
+#if defined(PLATFORM_WEB) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define RLIMGUI_NO_THREADS
+#elif defined(_WIN32)
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RLIMGUI_ATOMIC_STORE(target, value) _InterlockedExchange((volatile long*)(target), (value))
+#define RLIMGUI_ATOMIC_LOAD(target) _InterlockedOr((volatile long*)(target), 0)
+#define RLIMGUI_ATOMIC_EXCHANGE(target, value) _InterlockedExchange((volatile long*)(target), (value))
+#else
+#define RLIMGUI_ATOMIC_STORE(target, value) __atomic_store_n((target), (value), __ATOMIC_RELEASE)
+#define RLIMGUI_ATOMIC_LOAD(target) __atomic_load_n((target), __ATOMIC_ACQUIRE)
+#define RLIMGUI_ATOMIC_EXCHANGE(target, value) __atomic_exchange_n((target), (value), __ATOMIC_ACQ_REL)
+#endif
+
+// Dear ImGui 1.92 hands texture management to the backend (ImGuiBackendFlags_RendererHasTextures): font atlases grow as
+// glyphs are used and the backend is asked to create, update and destroy their textures. Define RLIMGUI_DYNAMIC_TEXTURES
+// when the cimgui headers don't define IMGUI_HAS_TEXTURES, or RLIMGUI_NO_DYNAMIC_TEXTURES to keep prebaked atlases
+#if defined(IMGUI_HAS_TEXTURES) && !defined(RLIMGUI_NO_DYNAMIC_TEXTURES) && !defined(RLIMGUI_DYNAMIC_TEXTURES)
+#define RLIMGUI_DYNAMIC_TEXTURES
 #endif
 
 #define nullptr 0
 
-static ImGuiMouseCursor CurrentMouseCursor = ImGuiMouseCursor_COUNT;
 static MouseCursor MouseCursorMap[ImGuiMouseCursor_COUNT];
 
-ImGuiContext* GlobalContext = nullptr;
-
 typedef struct
 {
     KeyboardKey RaylibKey;
@@ -163,534 +240,5426 @@ static KeyPairing RaylibKeyMap[] = {
     { KEY_KP_EQUAL, ImGuiKey_KeypadEqual},
 };
 
-static bool LastFrameFocused = false;
+// Idle frame skipping, ImGui keeps getting new frames for a while after the last input so it can settle
+#ifndef RLIMGUI_IDLE_GRACE_TIME
+#define RLIMGUI_IDLE_GRACE_TIME 1.0
+#endif
 
-static bool LastControlPressed = false;
-static bool LastShiftPressed = false;
-static bool LastAltPressed = false;
-static bool LastSuperPressed = false;
+typedef struct
+{
+    bool FrameSkipped;          // rlImGuiEnd re-renders the last frame instead of building one
+    bool RedrawRequested;
+    double LastActivityTime;
+    double LastFrameTime;       // time the last ImGui frame was started, for the delta of the next one
+} IdleFrameState;
 
-// internal only functions
-bool rlImGuiIsControlDown() { return IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_CONTROL); }
-bool rlImGuiIsShiftDown() { return IsKeyDown(KEY_RIGHT_SHIFT) || IsKeyDown(KEY_LEFT_SHIFT); }
-bool rlImGuiIsAltDown() { return IsKeyDown(KEY_RIGHT_ALT) || IsKeyDown(KEY_LEFT_ALT); }
-bool rlImGuiIsSuperDown() { return IsKeyDown(KEY_RIGHT_SUPER) || IsKeyDown(KEY_LEFT_SUPER); }
+// raylib's event waiting is global, so it is not part of the per context idle state
+static bool IdleEventWaiting = false;
+static bool EventWaitingActive = false;
 
-void ReloadFonts(void)
+
+// An owned copy of a frame's draw data, so it can be drawn again after ImGui has moved on to the next frame.
+// The arenas are reused from frame to frame and only grow.
+typedef struct
 {
-    ImGuiIO* io = igGetIO();
-    unsigned char* pixels = nullptr;
+    ImDrawData DrawData;
+    ImDrawList* Lists;
+    ImDrawList** ListPointers;
+    int ListCapacity;
+    ImDrawCmd* Commands;
+    int CommandCapacity;
+    ImDrawVert* Vertices;
+    int VertexCapacity;
+    ImDrawIdx* Indices;
+    int IndexCapacity;
+    char* Names;
+    int NameCapacity;
+    bool Valid;
+} DrawDataSnapshot;
+
+#define RLIMGUI_SNAPSHOT_FRESH 4
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+// A texture request of a frame built by rlImGuiEndContext. The builder can't make GL calls, so it answers the request
+// with a texture that is only created when the frame is handed over, and copies the pixels while ImGui leaves them alone.
+typedef struct
+{
+    ImTextureStatus Status;     // WantCreate, WantUpdates or WantDestroy
+    Texture2D* Texture;
+    ImTextureFormat Format;
+    int X, Y, Width, Height;    // the whole texture for WantCreate
+    unsigned char* Pixels;      // packed rows of the rect
+} TextureRequest;
 
-    int width;
-    int height;
-    ImFontAtlas_GetTexDataAsRGBA32(io->Fonts, &pixels, &width, &height, nullptr);
-    Image image = GenImageColor(width, height, BLANK);
-    memcpy(image.data, pixels, width * height * 4);
+typedef struct
+{
+    TextureRequest* Data;
+    int Count;
+    int Capacity;
+} TextureRequestList;
+#endif
 
-    Texture2D* fontTexture = (Texture2D*)io->Fonts->TexID;
-    if (fontTexture && fontTexture->id != 0)
-    {
-        UnloadTexture(*fontTexture);
-        MemFree(fontTexture);
-    }
+// Frames of a context built with rlImGuiBeginContext/rlImGuiEndContext, which can run on another thread than
+// rlImGuiRenderContext. The builder fills one snapshot while the render thread draws another, finished frames are handed
+// over by exchanging the index of the third one.
+typedef struct
+{
+    DrawDataSnapshot Snapshots[3];
+    int Write;              // only used by rlImGuiEndContext
+    int Read;               // only used by rlImGuiRenderContext
+    long Latest;            // the last finished frame, with RLIMGUI_SNAPSHOT_FRESH until the render thread picked it up
+    long Lock;              // held while Latest is exchanged together with the texture requests of the frame
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    TextureRequestList Requests;    // of the published frames, taken by the render thread with the latest frame
+    TextureRequestList Applying;    // only used by rlImGuiRenderContext
+#endif
+} ContextFrameQueue;
 
-    fontTexture = (Texture2D*)MemAlloc(sizeof(Texture2D));
-    *fontTexture = LoadTextureFromImage(image);
-    UnloadImage(image);
-    io->Fonts->TexID = (ImTextureID)fontTexture;
-}
+// GPU buffers used by the retained renderer, shared by every draw list in a frame
+typedef struct
+{
+    unsigned int VaoId;
+    unsigned int VboId;
+    unsigned int IboId;
+    int VtxCapacity;
+    int IdxCapacity;
+} RetainedBuffers;
+
+static RetainedBuffers Retained = { 0 };
+
+// Dedicated rlgl batch for the immediate path, so ImGui never shares the default batch with the game
+// and is sized for a whole frame of ImGui vertices instead of the default batch capacity
+#ifndef RLIMGUI_MAX_BATCH_ELEMENTS
+#define RLIMGUI_MAX_BATCH_ELEMENTS (1 << 17)   // rlgl elements are quads, so this is 4 times as many vertices
+#endif
 
-static const char* GetClipTextCallback(ImGuiContext* context)
+#define RLIMGUI_MIN_BATCH_ELEMENTS 8192         // same as the rlgl default batch
+
+typedef struct
 {
-    return GetClipboardText();
-}
+    rlRenderBatch Batch;
+    int Elements;
+} ImGuiRenderBatch;
 
-static void SetClipTextCallback(ImGuiContext* context, const char* text)
+static ImGuiRenderBatch DedicatedBatch = { 0 };
+
+// Structure of arrays vertex streams for the streamed path, filled by a de-indexing kernel and drawn without indices
+typedef struct
 {
-    SetClipboardText(text);
+    unsigned int VaoId;
+    unsigned int PositionVboId;
+    unsigned int TexCoordVboId;
+    unsigned int ColorVboId;
+    int Capacity;
+    float* Positions;
+    float* TexCoords;
+    unsigned int* Colors;
+} VertexStreams;
+
+// A run of streamed vertices drawn with one texture and clip rect, or a user callback
+typedef struct
+{
+    const ImDrawList* List;
+    const ImDrawCmd* Cmd;
+    int FirstVertex;
+    int VertexCount;
+} StreamDraw;
+
+typedef void (*DeinterleaveKernel)(const ImDrawVert* vertices, const ImDrawIdx* indices, int count, float* positions, float* texcoords, unsigned int* colors);
+
+static VertexStreams Streams = { 0 };
+static StreamDraw* StreamDraws = nullptr;
+static int StreamDrawCapacity = 0;
+static DeinterleaveKernel StreamKernel = nullptr;
+static const char* StreamKernelName = "none";
+
+// Whole frame output cache, the UI is composited from the last rendered frame while the draw data doesn't change
+typedef struct
+{
+    bool Enabled;
+    bool Valid;
+    uint64_t Hash;
+    RenderTexture2D Target;
+    unsigned int Hits;
+    unsigned int Misses;
+} FrameOutputCache;
+
+static void UnloadFrameCache(FrameOutputCache* cache)
+{
+    if (cache->Target.id != 0)
+        UnloadRenderTexture(cache->Target);
+
+    cache->Target = (RenderTexture2D){ 0 };
+    cache->Valid = false;
 }
 
-static void ImGuiNewFrame(float deltaTime)
+// Fragment shaders used by the backend are written once, the header picks the GLSL dialect of the rlgl version.
+// They run with raylib's default vertex shader, so they get the same attributes and uniforms as the default shader.
+static const char* ShaderHeader330 =
+    "#version 330\n"
+    "#define IN in\n"
+    "#define TEXTURE texture\n"
+    "out vec4 finalColor;\n";
+
+static const char* ShaderHeader100 =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "#define IN varying\n"
+    "#define TEXTURE texture2D\n"
+    "#define finalColor gl_FragColor\n";
+
+// returns a shader with an id of 0 when shaders are not available (OpenGL 1.1) or the source did not compile
+static Shader LoadBackendShader(const char* body)
 {
-    ImGuiIO* io = igGetIO();
+    if (rlGetVersion() == RL_OPENGL_11)
+        return (Shader){ 0 };
 
-    Vector2 resolutionScale = GetWindowScaleDPI();
+    const char* header = (rlGetVersion() == RL_OPENGL_ES_20) ? ShaderHeader100 : ShaderHeader330;
+    char* source = (char*)MemAlloc((unsigned int)(strlen(header) + strlen(body) + 1));
+    strcpy(source, header);
+    strcat(source, body);
 
-#ifndef PLATFORM_DRM
-    if (IsWindowFullscreen())
-    {
-        int monitor = GetCurrentMonitor();
-        io->DisplaySize.x = (float)GetMonitorWidth(monitor);
-        io->DisplaySize.y = (float)GetMonitorHeight(monitor);
-    }
-    else
-    {
-        io->DisplaySize.x = (float)GetScreenWidth();
-        io->DisplaySize.y = (float)GetScreenHeight();
-    }
+    Shader shader = LoadShaderFromMemory(nullptr, source);
+    MemFree(source);
 
-#if !defined(__APPLE__)
-    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
-        resolutionScale = (Vector2){ 1,1 };
-#endif
-#else
-    io->DisplaySize.x = float(GetScreenWidth());
-    io->DisplaySize.y = float(GetScreenHeight());
-#endif
+    // raylib hands back the default shader when compiling fails
+    if (shader.id == rlGetShaderIdDefault())
+        return (Shader){ 0 };
 
-    io->DisplayFramebufferScale = (ImVec2){resolutionScale.x, resolutionScale.y};
+    return shader;
+}
 
-    if (deltaTime <= 0)
-        deltaTime = 0.001f;
+static Shader GetDefaultShader(void)
+{
+    return (Shader){ rlGetShaderIdDefault(), rlGetShaderLocsDefault() };
+}
 
-    io->DeltaTime = deltaTime;
+// Resolution scaling, the UI is rasterized into an offscreen target smaller than the display and stretched over it.
+// ImGui still lays out and gets input in display coordinates, only the number of pixels drawn changes.
+#define RLIMGUI_MIN_RESOLUTION_SCALE 0.25f
+
+typedef struct
+{
+    float Scale;            // fraction of the framebuffer resolution, 0 or 1 draws straight to the target
+    float Sharpness;        // strength of the sharpening filter used when upscaling, 0 is plain bilinear filtering
+    RenderTexture2D Target;
+} ResolutionScaling;
 
-    if (igGetIO()->BackendFlags & ImGuiBackendFlags_HasMouseCursors)
+// unsharp mask used when compositing a scaled frame, compiled on first use. The colors are premultiplied, so they are kept below alpha
+typedef struct
+{
+    bool Tried;
+    Shader Shader;
+    int TexelSizeLoc;
+    int SharpnessLoc;
+} SharpenFilter;
+
+static SharpenFilter Sharpen = { 0 };
+
+static const char* SharpenShaderBody =
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "uniform vec2 texelSize;\n"
+    "uniform float sharpness;\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 center = TEXTURE(texture0, fragTexCoord);\n"
+    "    vec4 blur = TEXTURE(texture0, fragTexCoord + vec2(texelSize.x, 0.0)) + TEXTURE(texture0, fragTexCoord - vec2(texelSize.x, 0.0));\n"
+    "    blur += TEXTURE(texture0, fragTexCoord + vec2(0.0, texelSize.y)) + TEXTURE(texture0, fragTexCoord - vec2(0.0, texelSize.y));\n"
+    "    vec4 color = center + (center - blur * 0.25) * sharpness;\n"
+    "    color.a = clamp(color.a, 0.0, 1.0);\n"
+    "    color.rgb = clamp(color.rgb, vec3(0.0), vec3(color.a));\n"
+    "    finalColor = color * fragColor * colDiffuse;\n"
+    "}\n";
+
+static bool LoadSharpenFilter(void)
+{
+    if (!Sharpen.Tried)
     {
-        if ((io->ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) == 0)
+        Sharpen.Tried = true;
+        Sharpen.Shader = LoadBackendShader(SharpenShaderBody);
+        if (Sharpen.Shader.id != 0)
         {
-            ImGuiMouseCursor imgui_cursor = igGetMouseCursor();
-            if (imgui_cursor != CurrentMouseCursor || io->MouseDrawCursor)
-            {
-                CurrentMouseCursor = imgui_cursor;
-                if (io->MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None)
-                {
-                    HideCursor();
-                }
-                else
-                {
-                    ShowCursor();
-
-                    if (!(io->ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange))
-                    {
-                        SetMouseCursor((imgui_cursor > -1 && imgui_cursor < ImGuiMouseCursor_COUNT) ? MouseCursorMap[imgui_cursor] : MOUSE_CURSOR_DEFAULT);
-                    }
-                }
-            }
+            Sharpen.TexelSizeLoc = GetShaderLocation(Sharpen.Shader, "texelSize");
+            Sharpen.SharpnessLoc = GetShaderLocation(Sharpen.Shader, "sharpness");
         }
     }
-}
 
-static void ImGuiTriangleVert(const ImDrawVert* idx_vert)
-{
-    Color* c;
-    c = (Color*)&idx_vert->col;
-    rlColor4ub(c->r, c->g, c->b, c->a);
-    rlTexCoord2f(idx_vert->uv.x, idx_vert->uv.y);
-    rlVertex2f(idx_vert->pos.x, idx_vert->pos.y);
+    return Sharpen.Shader.id != 0;
 }
 
-static void ImGuiRenderTriangles(unsigned int count, int indexStart, const ImDrawIdx* indexBuffer, const ImDrawVert* vertBuffer, void* texturePtr)
+static void UnloadSharpenFilter(void)
 {
-    if (count < 3)
-        return;
-
-    Texture* texture = (Texture*)texturePtr;
+    if (Sharpen.Shader.id != 0)
+        UnloadShader(Sharpen.Shader);
 
-    unsigned int textureId = (texture == nullptr) ? 0 : texture->id;
+    Sharpen = (SharpenFilter){ 0 };
+}
 
-    rlBegin(RL_TRIANGLES);
-    rlSetTexture(textureId);
+// Font textures uploaded with one alpha byte per texel. A single channel texture samples as (a, a, a, 1),
+// so commands using one are drawn with a shader that turns it back into white with alpha.
+#ifndef RLIMGUI_MAX_ALPHA_TEXTURES
+#define RLIMGUI_MAX_ALPHA_TEXTURES 32
+#endif
 
-    for (unsigned int i = 0; i <= (count - 3); i += 3)
+typedef struct
+{
+    bool Tried;
+    Shader Shader;
+    unsigned int TextureIds[RLIMGUI_MAX_ALPHA_TEXTURES];
+    int TextureCount;
+} AlphaTextureSet;
+
+static AlphaTextureSet AlphaTextures = { 0 };
+
+static const char* AlphaShaderBody =
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    finalColor = vec4(1.0, 1.0, 1.0, TEXTURE(texture0, fragTexCoord).r) * fragColor * colDiffuse;\n"
+    "}\n";
+
+static bool LoadAlphaShader(void)
+{
+    if (!AlphaTextures.Tried)
     {
-        const ImDrawIdx indexA = indexBuffer[indexStart + i];
-        const ImDrawIdx indexB = indexBuffer[indexStart + i + 1];
-        const ImDrawIdx indexC = indexBuffer[indexStart + i + 2];
+        AlphaTextures.Tried = true;
+        AlphaTextures.Shader = LoadBackendShader(AlphaShaderBody);
+    }
 
-        const ImDrawVert* vertexA = vertBuffer + indexA;
-        const ImDrawVert* vertexB = vertBuffer + indexB;
-        const ImDrawVert* vertexC = vertBuffer + indexC;
+    return AlphaTextures.Shader.id != 0;
+}
 
-        ImGuiTriangleVert(vertexA);
-        ImGuiTriangleVert(vertexB);
-        ImGuiTriangleVert(vertexC);
+static bool IsAlphaTexture(unsigned int textureId)
+{
+    for (int i = 0; i < AlphaTextures.TextureCount; ++i)
+    {
+        if (AlphaTextures.TextureIds[i] == textureId)
+            return true;
     }
-    rlEnd();
+    return false;
 }
 
-static void EnableScissor(float x, float y, float width, float height)
+static void RemoveAlphaTexture(unsigned int textureId)
 {
-    rlEnableScissorTest();
-    ImGuiIO* io = igGetIO();
-
-    ImVec2 scale = io->DisplayFramebufferScale;
-#if !defined(__APPLE__)
-    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+    for (int i = 0; i < AlphaTextures.TextureCount; ++i)
     {
-        scale.x = 1;
-        scale.y = 1;
+        if (AlphaTextures.TextureIds[i] == textureId)
+        {
+            AlphaTextures.TextureIds[i] = AlphaTextures.TextureIds[--AlphaTextures.TextureCount];
+            return;
+        }
     }
+}
+
+// Fonts loaded by rlImGuiLoadSDFFont. Each one has its own atlas of signed distance field glyphs, drawn with a shader
+// that keeps the glyph edges one pixel wide at any size
+#ifndef RLIMGUI_MAX_SDF_FONTS
+#define RLIMGUI_MAX_SDF_FONTS 8
 #endif
 
-    rlScissor((int)(x * scale.x),
-        (int)((io->DisplaySize.y - (int)(y + height)) * scale.y),
-        (int)(width * scale.x),
-        (int)(height * scale.y));
-}
+// empty texels around each glyph in the atlas, at least the spread of raylib's distance fields (FONT_SDF_CHAR_PADDING).
+// The field of a neighbouring glyph would otherwise be filtered into the edge of the quad
+#ifndef RLIMGUI_SDF_PADDING
+#define RLIMGUI_SDF_PADDING 4
+#endif
 
-static void SetupMouseCursors(void)
+typedef struct
 {
-    MouseCursorMap[ImGuiMouseCursor_Arrow] = MOUSE_CURSOR_ARROW;
-    MouseCursorMap[ImGuiMouseCursor_TextInput] = MOUSE_CURSOR_IBEAM;
-    MouseCursorMap[ImGuiMouseCursor_Hand] = MOUSE_CURSOR_POINTING_HAND;
-    MouseCursorMap[ImGuiMouseCursor_ResizeAll] = MOUSE_CURSOR_RESIZE_ALL;
-    MouseCursorMap[ImGuiMouseCursor_ResizeEW] = MOUSE_CURSOR_RESIZE_EW;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNESW] = MOUSE_CURSOR_RESIZE_NESW;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNS] = MOUSE_CURSOR_RESIZE_NS;
-    MouseCursorMap[ImGuiMouseCursor_ResizeNWSE] = MOUSE_CURSOR_RESIZE_NWSE;
-    MouseCursorMap[ImGuiMouseCursor_NotAllowed] = MOUSE_CURSOR_NOT_ALLOWED;
+    bool Tried;
+    Shader Shader;
+    ImFontAtlas* Atlases[RLIMGUI_MAX_SDF_FONTS];
+    unsigned int TextureIds[RLIMGUI_MAX_SDF_FONTS];
+    unsigned char* FileData[RLIMGUI_MAX_SDF_FONTS];    // the font config of the atlas can point to it
+    int Count;
+} SDFFontSet;
+
+static SDFFontSet SDFFonts = { 0 };
+
+// the distance is 0.5 on the glyph outline, as written by raylib's FONT_SDF glyphs
+static const char* SDFShaderBody =
+    "IN vec2 fragTexCoord;\n"
+    "IN vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "uniform vec4 colDiffuse;\n"
+    "void main()\n"
+    "{\n"
+    "    float distance = TEXTURE(texture0, fragTexCoord).r - 0.5;\n"
+    "    float width = max(fwidth(distance), 0.0001);\n"
+    "    float alpha = smoothstep(-width, width, distance);\n"
+    "    finalColor = vec4(1.0, 1.0, 1.0, alpha) * fragColor * colDiffuse;\n"
+    "}\n";
+
+static bool LoadSDFShader(void)
+{
+    if (!SDFFonts.Tried)
+    {
+        SDFFonts.Tried = true;
+        SDFFonts.Shader = LoadBackendShader(SDFShaderBody);
+    }
+
+    return SDFFonts.Shader.id != 0;
 }
 
-void SetupFontAwesome(void)
+static bool IsSDFTexture(unsigned int textureId)
 {
-#ifndef NO_FONT_AWESOME
-    static const ImWchar icons_ranges[] = { ICON_MIN_FA, ICON_MAX_FA, 0 };
-    ImFontConfig icons_config;
-    icons_config.MergeMode = true;
-    icons_config.PixelSnapH = true;
-    icons_config.FontDataOwnedByAtlas = false;
+    for (int i = 0; i < SDFFonts.Count; ++i)
+    {
+        if (SDFFonts.TextureIds[i] == textureId)
+            return true;
+    }
+    return false;
+}
 
-    icons_config.GlyphMaxAdvanceX = std::numeric_limits<float>::max();
-    icons_config.RasterizerMultiply = 1.0f;
-    icons_config.OversampleH = 2;
-    icons_config.OversampleV = 1;
+// the shader a texture has to be drawn with
+static Shader GetTextureShader(unsigned int textureId)
+{
+    if (SDFFonts.Count > 0 && IsSDFTexture(textureId))
+        return SDFFonts.Shader;
 
-    icons_config.GlyphRanges = icons_ranges;
+    return (AlphaTextures.TextureCount > 0 && IsAlphaTexture(textureId)) ? AlphaTextures.Shader : GetDefaultShader();
+}
 
-    ImGuiIO* io = igGetIO();
+static void UnloadAlphaShader(void)
+{
+    // the shader is shared by every context, it has to stay while any of them still has an alpha texture
+    if (AlphaTextures.TextureCount > 0)
+        return;
 
-    ImFontAtlas_AddFontFromMemoryCompressedTTF(io->Fonts, (void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, FONT_AWESOME_ICON_SIZE, &icons_config, icons_ranges);
-#endif
+    if (AlphaTextures.Shader.id != 0)
+        UnloadShader(AlphaTextures.Shader);
 
+    AlphaTextures = (AlphaTextureSet){ 0 };
 }
 
-void SetupBackend(void)
+// ImGui 1.92 draw commands reference textures through an ImTextureRef, resolved once the backend created the texture
+static ImTextureID GetCommandTextureId(const ImDrawCmd* cmd)
 {
-    ImGuiIO* io = igGetIO();
-    io->BackendPlatformName = "imgui_impl_raylib";
-    io->BackendFlags |= ImGuiBackendFlags_HasGamepad | ImGuiBackendFlags_HasSetMousePos;
-
-#ifndef PLATFORM_DRM
-    io->BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    return ImDrawCmd_GetTexID((ImDrawCmd*)cmd);
+#else
+    return cmd->TextureId;
 #endif
-
-    io->MousePos = (ImVec2){0, 0};
-
-    ImGuiPlatformIO* platformIO = igGetPlatformIO();
-
-    platformIO->Platform_SetClipboardTextFn = SetClipTextCallback;
-    platformIO->Platform_GetClipboardTextFn = GetClipTextCallback;
-    platformIO->Platform_ClipboardUserData = nullptr;
 }
 
-void rlImGuiEndInitImGui(void)
+static Texture* GetCommandTexture(const ImDrawCmd* cmd)
 {
-    igSetCurrentContext(GlobalContext);
+    return (Texture*)(uintptr_t)GetCommandTextureId(cmd);
+}
 
-    SetupFontAwesome();
+// Per window layers, draw lists that stop changing are rendered once to their own texture and composited after that
+#ifndef RLIMGUI_MAX_WINDOW_LAYERS
+#define RLIMGUI_MAX_WINDOW_LAYERS 16
+#endif
 
-    SetupMouseCursors();
+// lists smaller than this are cheaper to draw than to composite
+#ifndef RLIMGUI_LAYER_MIN_VERTICES
+#define RLIMGUI_LAYER_MIN_VERTICES 1024
+#endif
 
-    SetupBackend();
+// number of frames a list has to stay the same before it is given a layer
+#ifndef RLIMGUI_LAYER_STABLE_FRAMES
+#define RLIMGUI_LAYER_STABLE_FRAMES 2
+#endif
 
-    ReloadFonts();
-}
+// layer textures are sized in multiples of this many pixels
+#ifndef RLIMGUI_LAYER_SIZE_STEP
+#define RLIMGUI_LAYER_SIZE_STEP 64
+#endif
 
-static void SetupGlobals(void)
-{
-    LastFrameFocused = IsWindowFocused();
-    LastControlPressed = false;
-    LastShiftPressed = false;
-    LastAltPressed = false;
-    LastSuperPressed = false;
-}
+// lists after this one in a frame are always drawn live
+#define RLIMGUI_MAX_LAYERED_LISTS 256
 
-void rlImGuiBeginInitImGui(void)
+typedef struct
 {
-    SetupGlobals();
-    if (GlobalContext == nullptr)
-        GlobalContext = igCreateContext(nullptr);
-
-    ImGuiIO* io = igGetIO();
-
-    ImFontAtlas_AddFontDefault(io->Fonts, nullptr);
-}
+    const ImDrawList* List;
+    uint64_t OwnerHash;
+    uint64_t ContentHash;
+    int StableFrames;
+    unsigned int LastUsedFrame;
+    bool Valid;
+    Rectangle Bounds;
+    int Width;
+    int Height;
+    RenderTexture2D Target;
+} WindowLayer;
 
-void rlImGuiSetup(bool dark)
+typedef struct
 {
-    rlImGuiBeginInitImGui();
-
-    ImGuiStyle* style = igGetStyle();
+    bool Enabled;
+    unsigned int FrameIndex;
+    WindowLayer Layers[RLIMGUI_MAX_WINDOW_LAYERS];
+    WindowLayer* ListLayers[RLIMGUI_MAX_LAYERED_LISTS];
+} WindowLayerCache;
 
-    if (dark)
-        igStyleColorsDark(style);
-    else
-        igStyleColorsLight(style);
+static void UnloadWindowLayer(WindowLayer* layer)
+{
+    if (layer->Target.id != 0)
+        UnloadRenderTexture(layer->Target);
 
-    rlImGuiEndInitImGui();
+    *layer = (WindowLayer){ 0 };
 }
 
-void rlImGuiSetContext(ImGuiContext *imgui_context)
+static void UnloadWindowLayers(WindowLayerCache* cache)
 {
-    GlobalContext = imgui_context;
+    for (int i = 0; i < RLIMGUI_MAX_WINDOW_LAYERS; ++i)
+        UnloadWindowLayer(cache->Layers + i);
 }
 
-ImGuiContext* rlImGuiGetContext()
+static void InvalidateWindowLayers(WindowLayerCache* cache)
 {
-    return GlobalContext;
+    for (int i = 0; i < RLIMGUI_MAX_WINDOW_LAYERS; ++i)
+        cache->Layers[i].Valid = false;
 }
 
-void rlImGuiReloadFonts(void)
+// Framebuffer and matrices of the outer target, restored after rendering to an offscreen target
+static unsigned int OuterFramebuffer;
+static int OuterWidth;
+static int OuterHeight;
+static Matrix OuterModelview;
+static Matrix OuterProjection;
+
+// binds a render texture, keeping the state of the outer target so it can be restored
+static void BeginRenderTarget(RenderTexture2D target)
 {
-    igSetCurrentContext(GlobalContext);
+    rlDrawRenderBatchActive();
+    OuterFramebuffer = rlGetActiveFramebuffer();
+    OuterWidth = rlGetFramebufferWidth();
+    OuterHeight = rlGetFramebufferHeight();
+    OuterModelview = rlGetMatrixModelview();
+    OuterProjection = rlGetMatrixProjection();
 
-    ReloadFonts();
+    BeginTextureMode(target);
 }
 
-void rlImGuiBegin(void)
+// binds an offscreen target, with ImGui coordinates starting at origin and scaled to target pixels
+static void BeginOffscreenTarget(RenderTexture2D target, ImVec2 origin, ImVec2 scale)
 {
-    igSetCurrentContext(GlobalContext);
-    rlImGuiBeginDelta(GetFrameTime());
+    BeginRenderTarget(target);
+    ClearBackground(BLANK);
+
+    rlScalef(scale.x, scale.y, 1);
+    rlTranslatef(-origin.x, -origin.y, 0);
 }
 
-void rlImGuiBeginDelta(float deltaTime)
+static void EndOffscreenTarget(void)
 {
-    igSetCurrentContext(GlobalContext);
+    EndTextureMode();
 
-    ImGuiNewFrame(deltaTime);
-    ImGui_ImplRaylib_ProcessEvents();
-    igNewFrame();
-}
+    // EndTextureMode always goes back to the screen, the application may be drawing into its own render texture
+    rlEnableFramebuffer(OuterFramebuffer);
+    rlViewport(0, 0, OuterWidth, OuterHeight);
+    rlSetFramebufferWidth(OuterWidth);
+    rlSetFramebufferHeight(OuterHeight);
 
-void rlImGuiEnd(void)
-{
-    igSetCurrentContext(GlobalContext);
-    igRender();
-    ImGui_ImplRaylib_RenderDrawData(igGetDrawData());
+    // EndTextureMode resets the screen matrices, put back the ones the application had (HighDPI scale, cameras)
+    rlSetMatrixProjection(OuterProjection);
+    rlSetMatrixModelview(OuterModelview);
 }
 
-void rlImGuiShutdown(void)
+// Render state as last applied by the backend, so redundant state changes can be skipped.
+// Every value starts a frame as unknown (-1), user code may have changed anything between frames.
+// This one stays global: it mirrors the state of the GL context, which every rlImGui context draws with.
+typedef struct
 {
-    if (GlobalContext == nullptr)
-        return;
+    int ScissorEnabled;
+    int ScissorX;
+    int ScissorY;
+    int ScissorWidth;
+    int ScissorHeight;
+    int TextureId;
+    int ShaderId;
+    int BlendMode;
+    int CullingEnabled;
+} RenderStateCache;
+
+static RenderStateCache RenderState;
+
+// Values used to map ImGui coordinates to the framebuffer, computed once per frame
+typedef struct
+{
+    ImVec2 DisplayPos;
+    ImVec2 DisplaySize;
+    ImVec2 FramebufferScale;
+} RenderTargetInfo;
+
+// Icons drawn by rlImGuiIcon. Font Awesome glyphs are rasterized on first use at the size they are drawn at, into
+// pages of their own instead of the font atlas. Pages never move or change size once created, so texture ids and
+// coordinates stay valid for draw data that is rendered later. When all pages are full, the least recently used page is cleared.
+#ifndef RLIMGUI_ICON_PAGE_SIZE
+#define RLIMGUI_ICON_PAGE_SIZE 512
+#endif
+
+#ifndef RLIMGUI_MAX_ICON_PAGES
+#define RLIMGUI_MAX_ICON_PAGES 4
+#endif
+
+// a page used by one of the last frames may still be drawn, it isn't cleared
+#define RLIMGUI_ICON_PAGE_KEEP_FRAMES 4
+
+typedef struct
+{
+    Texture2D Texture;
+    int ShelfX;
+    int ShelfY;
+    int ShelfHeight;
+    unsigned int LastUsed;
+} IconPage;
+
+typedef struct
+{
+    int Codepoint;
+    int PixelSize;
+    int Page;
+    Rectangle Source;       // the glyph pixels in the page
+    Vector2 Offset;         // from the top left of the line, in pixels
+    float Advance;
+} IconGlyph;
+
+typedef struct
+{
+    IconPage Pages[RLIMGUI_MAX_ICON_PAGES];
+    int PageCount;
+    int CurrentPage;        // the page new icons are packed into
+    IconGlyph* Glyphs;
+    int GlyphCount;
+    int GlyphCapacity;
+    unsigned int Frame;
+} IconAtlasState;
+
+#if defined(_MSC_VER)
+#define RLIMGUI_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define RLIMGUI_THREAD_LOCAL _Thread_local
+#else
+#define RLIMGUI_THREAD_LOCAL __thread
+#endif
+
+// A font atlas built on a worker thread. The atlas is only touched by the worker until Done is set,
+// then the main thread uploads it and swaps it in at the start of the next frame.
+// With dynamic textures only Setup and UserData are used, the setup is run on the live atlas at the next frame
+typedef struct
+{
+    ImFontAtlas* Atlas;
+    rlImGuiFontAtlasSetup Setup;
+    void* UserData;
+    long Done;
+    float Density;              // rasterizer density set on every font before the build, 0 keeps the one in the font configs
+    bool ScaleOnly;             // the job rebuilds the active fonts for another display scale, see ScaledFontAtlasCache
+    ImFontAtlas* Retired;       // the previous atlas, freed one frame later because the last frame still draws with its texture
+    unsigned char* GlyphProfile;    // copy of the loaded glyph profile, owned by the job
+    char CacheDirectory[512];       // copy of the font cache directory
+} FontBuildJob;
+
+// Font atlases for the display scales the window was on before. Each one holds the active fonts rasterized at its scale,
+// so moving back to a monitor swaps it in without rasterizing anything. Least recently used atlases are freed first
+#ifndef RLIMGUI_MAX_SCALED_FONT_ATLASES
+#define RLIMGUI_MAX_SCALED_FONT_ATLASES 4
+#endif
+
+// memory the inactive atlases may use together, counting font data, CPU pixels and the texture
+#ifndef RLIMGUI_SCALED_FONT_ATLAS_MEMORY
+#define RLIMGUI_SCALED_FONT_ATLAS_MEMORY (32 * 1024 * 1024)
+#endif
+
+typedef struct
+{
+    float Scale;
+    ImFontAtlas* Atlas;
+    size_t Bytes;
+    double LastUsed;
+} ScaledFontAtlas;
+
+typedef struct
+{
+    bool Enabled;
+    float Scale;            // rasterizer density of the fonts in io.Fonts
+    ScaledFontAtlas Atlases[RLIMGUI_MAX_SCALED_FONT_ATLASES];
+    int Count;
+} ScaledFontAtlasCache;
+
+// Window state a frame is started with. rlImGuiBeginContext can run on a worker thread, where raylib's window functions
+// can't be used, so it starts frames with the state rlImGuiRenderContext sampled on the main thread.
+typedef struct
+{
+    Vector2 Scale;          // screen units to framebuffer pixels
+    ImVec2 Size;            // the window, or the monitor in fullscreen
+    float DeltaTime;
+} WindowState;
+
+// Backend state that belongs to one ImGui context. The rlImGui API works on the current context of the calling thread,
+// which is the default context unless rlImGuiSetCurrentContext or rlImGuiBeginContext picked another one.
+struct rlImGuiContext
+{
+    ImGuiContext* ImGui;
+    bool SharedAtlas;       // the ImGui context uses SharedFonts.Atlas
+
+    // input edge state, events are only sent to ImGui when something changes
+    bool ReceivesInput;
+    ImGuiMouseCursor CurrentMouseCursor;
+    bool LastFrameFocused;
+    bool LastControlPressed;
+    bool LastShiftPressed;
+    bool LastAltPressed;
+    bool LastSuperPressed;
+    ImVec2 LastMousePos;
+
+    // size of the UI in screen units and where it is drawn, a zero size and no target use the raylib window
+    ImVec2 DisplaySize;
+    const RenderTexture* RenderTarget;
+
+    IdleFrameState Idle;
+    DrawDataSnapshot Snapshot;
+    ContextFrameQueue ContextFrames;
+    WindowState Window;     // sampled for rlImGuiBeginContext
+    bool FramePending;
+    double FrameBuildStart;
+    float FrameBuildMilliseconds;
+    FrameOutputCache FrameCache;
+    ResolutionScaling Resolution;
+    FontBuildJob FontBuild;
+    ScaledFontAtlasCache ScaledFonts;
+
+    // frame pacing and rendering
+    rlImGuiRenderMode RenderMode;
+    float UpdateInterval;       // seconds between ImGui frames when using rlImGuiBeginIfNeeded, 0 updates every frame
+    int FrameLatency;           // with 1, rlImGuiEnd keeps a snapshot that is drawn by the next rlImGuiBegin
+    rlImGuiRenderStats FrameStats;
+    RenderTargetInfo FrameTarget;   // maps ImGui coordinates to the framebuffer, computed once per frame
+    WindowLayerCache WindowLayers;
+    IconAtlasState IconAtlas;   // pages hold the icons of this context's frames, so they age with its frames only
+    bool BackendReady;          // counted in BackendRefCount
+
+    rlImGuiContext* NextContext;    // contexts made by rlImGuiCreateContext are listed after the default context
+};
+
+static rlImGuiContext DefaultContext = { nullptr, false, true, ImGuiMouseCursor_COUNT };
+static RLIMGUI_THREAD_LOCAL rlImGuiContext* CurrentContext = &DefaultContext;
+
+static float GetResolutionScale(const rlImGuiContext* context)
+{
+    float scale = context->Resolution.Scale;
+    return (scale > 0 && scale < 1) ? scale : 1;
+}
+
+// scale from screen units to framebuffer pixels for the current context
+static Vector2 GetDisplayScale(void)
+{
+    // contexts that draw to their own area are not affected by the window DPI scale
+    if ((CurrentContext->DisplaySize.x > 0 && CurrentContext->DisplaySize.y > 0) || CurrentContext->RenderTarget != nullptr)
+        return (Vector2){ 1, 1 };
+
+#if !defined(PLATFORM_DRM) && !defined(__APPLE__)
+    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+        return (Vector2){ 1, 1 };
+#endif
+
+    return GetWindowScaleDPI();
+}
+
+// only on the main thread
+static WindowState SampleWindowState(void)
+{
+    WindowState window = { GetDisplayScale(), { (float)GetScreenWidth(), (float)GetScreenHeight() }, GetFrameTime() };
+
+#ifndef PLATFORM_DRM
+    if (IsWindowFullscreen())
+    {
+        int monitor = GetCurrentMonitor();
+        window.Size = (ImVec2){ (float)GetMonitorWidth(monitor), (float)GetMonitorHeight(monitor) };
+    }
+#endif
+
+    return window;
+}
+
+// One font atlas and font texture used by every context created while shared atlas mode is on.
+// The texture is stored in the atlas TexID like for any other atlas, so a rebuild is seen by every context.
+typedef struct
+{
+    bool Enabled;
+    ImFontAtlas* Atlas;
+    int RefCount;
+} SharedFontAtlas;
+
+static SharedFontAtlas SharedFonts = { 0 };
+
+// set while a frame is drawn into a render texture instead of the current raylib target
+static const RenderTexture* ActiveRenderTarget = nullptr;
+
+// internal only functions
+bool rlImGuiIsControlDown() { return IsKeyDown(KEY_RIGHT_CONTROL) || IsKeyDown(KEY_LEFT_CONTROL); }
+bool rlImGuiIsShiftDown() { return IsKeyDown(KEY_RIGHT_SHIFT) || IsKeyDown(KEY_LEFT_SHIFT); }
+bool rlImGuiIsAltDown() { return IsKeyDown(KEY_RIGHT_ALT) || IsKeyDown(KEY_LEFT_ALT); }
+bool rlImGuiIsSuperDown() { return IsKeyDown(KEY_RIGHT_SUPER) || IsKeyDown(KEY_LEFT_SUPER); }
+
+// 64 bit multiply/xor-shift hash, fast enough to run over every vertex of a frame
+static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+{
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ull;
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    while (size >= 8)
+    {
+        uint64_t word;
+        memcpy(&word, bytes, 8);
+        hash = (hash ^ (word * multiplier)) * multiplier;
+        hash ^= hash >> 29;
+        bytes += 8;
+        size -= 8;
+    }
+
+    uint64_t tail = 0;
+    memcpy(&tail, bytes, size);
+    hash = (hash ^ (tail * multiplier) ^ size) * multiplier;
+    return hash ^ (hash >> 32);
+}
+
+static int FindFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int i = 0; i < atlas->Fonts.Size; ++i)
+    {
+        if (atlas->Fonts.Data[i] == font)
+            return i;
+    }
+    return -1;
+}
+
+// On disk cache for baked font atlases. The Alpha8 pixels, glyph tables and custom rects of a built atlas are saved
+// to a file named after a hash of everything that goes into the build, and loaded instead of rasterizing the fonts.
+// Atlases with dynamic textures rasterize glyphs as they are used, so there is nothing to cache for them
+#define RLIMGUI_FONT_CACHE_MAGIC 0x46494C52u      // "RLIF"
+#define RLIMGUI_FONT_CACHE_VERSION 1
+
+static char FontCacheDirectory[512] = { 0 };
+
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+
+typedef struct
+{
+    unsigned int Magic;
+    unsigned int Version;
+    uint64_t Key;
+    int TexWidth;
+    int TexHeight;
+    int FontCount;
+    int CustomRectCount;
+    int PackIdMouseCursors;
+    int PackIdLines;
+    ImVec2 TexUvWhitePixel;
+} FontCacheHeader;
+
+typedef struct
+{
+    float FontSize;
+    float Ascent;
+    float Descent;
+    int GlyphCount;
+} FontCacheFont;
+
+typedef struct
+{
+    unsigned char* Data;
+    int Size;
+    int Offset;
+} FontCacheStream;
+
+static bool FontCacheWrite(FontCacheStream* stream, const void* data, int size)
+{
+    if (stream->Offset + size > stream->Size)
+        return false;
+
+    if (stream->Data != nullptr)
+        memcpy(stream->Data + stream->Offset, data, size);
+    stream->Offset += size;
+    return true;
+}
+
+static bool FontCacheRead(FontCacheStream* stream, void* data, int size)
+{
+    if (size < 0 || stream->Offset + size > stream->Size)
+        return false;
+
+    memcpy(data, stream->Data + stream->Offset, size);
+    stream->Offset += size;
+    return true;
+}
+
+// hashes the font sources and every setting that changes the baked result. Pointers are cleared from the configs,
+// the data they point to is hashed instead
+static unsigned int ReadFontU32(const unsigned char* data)
+{
+    return ((unsigned int)data[0] << 24) | ((unsigned int)data[1] << 16) | ((unsigned int)data[2] << 8) | data[3];
+}
+
+// hashes the table directory of a TrueType/OpenType font instead of the whole file. The directory holds the size and
+// checksum of every table and sits at the start of the file, so only the first page of a mapped file is read.
+// Returns false when the data doesn't look like a font
+static bool HashFontDirectory(uint64_t* hash, const unsigned char* data, int size, int fontNo)
+{
+    size_t offset = 0;
+    if (size >= 12 && memcmp(data, "ttcf", 4) == 0)
+    {
+        // collections list the offset of each font's directory
+        if (fontNo < 0 || (unsigned int)fontNo >= ReadFontU32(data + 8) || 12 + 4 * ((size_t)fontNo + 1) > (size_t)size)
+            return false;
+        offset = ReadFontU32(data + 12 + 4 * fontNo);
+    }
+
+    if (offset + 12 > (size_t)size)
+        return false;
+
+    size_t length = 12 + 16 * (size_t)((data[offset + 4] << 8) | data[offset + 5]);
+    if (offset + length > (size_t)size)
+        return false;
+
+    *hash = HashBytes(*hash, &size, sizeof(size));
+    *hash = HashBytes(*hash, data + offset, length);
+    return true;
+}
+
+static uint64_t GetFontAtlasKey(const ImFontAtlas* atlas)
+{
+    static const int layout[] = { RLIMGUI_FONT_CACHE_VERSION, (int)sizeof(ImFontGlyph), (int)sizeof(ImFontConfig), (int)sizeof(ImFontAtlasCustomRect) };
+
+    // the cimgui headers don't carry IMGUI_VERSION_NUM, the version string comes from the compiled ImGui instead
+    const char* version = igGetVersion();
+
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hash = HashBytes(hash, layout, sizeof(layout));
+    hash = HashBytes(hash, version, strlen(version));
+    hash = HashBytes(hash, &atlas->Flags, sizeof(atlas->Flags));
+    hash = HashBytes(hash, &atlas->TexDesiredWidth, sizeof(atlas->TexDesiredWidth));
+    hash = HashBytes(hash, &atlas->TexGlyphPadding, sizeof(atlas->TexGlyphPadding));
+    hash = HashBytes(hash, &atlas->FontBuilderFlags, sizeof(atlas->FontBuilderFlags));
+
+    // the builder functions move between runs, only stb_truetype (the default) and another builder such as FreeType are told apart
+    int builder = (atlas->FontBuilderIO == nullptr || atlas->FontBuilderIO == igImFontAtlasGetBuilderForStbTruetype()) ? 0 : 1;
+    hash = HashBytes(hash, &builder, sizeof(builder));
+
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        ImFontConfig config = atlas->ConfigData.Data[i];
+        int fontIndex = FindFontIndex(atlas, config.DstFont);
+
+        // data the atlas doesn't own is a mapped file from rlImGuiAddFontFile, its pages are only read to rasterize
+        if (config.FontDataOwnedByAtlas || !HashFontDirectory(&hash, (const unsigned char*)config.FontData, config.FontDataSize, config.FontNo))
+            hash = HashBytes(hash, config.FontData, config.FontDataSize);
+        for (const ImWchar* range = config.GlyphRanges; range != nullptr && range[0] != 0; range += 2)
+            hash = HashBytes(hash, range, sizeof(ImWchar) * 2);
+
+        config.FontData = nullptr;
+        config.GlyphRanges = nullptr;
+        config.DstFont = nullptr;
+        config.FontDataOwnedByAtlas = false;
+        hash = HashBytes(hash, &config, sizeof(ImFontConfig));
+        hash = HashBytes(hash, &fontIndex, sizeof(fontIndex));
+    }
+
+    // rects added by the application before the build, their ids have to stay the same
+    for (int i = 0; i < atlas->CustomRects.Size; ++i)
+    {
+        const ImFontAtlasCustomRect* rect = atlas->CustomRects.Data + i;
+        int key[3] = { rect->Width, rect->Height, FindFontIndex(atlas, rect->Font) };
+        hash = HashBytes(hash, key, sizeof(key));
+        hash = HashBytes(hash, &rect->GlyphID, sizeof(rect->GlyphID));
+        hash = HashBytes(hash, &rect->GlyphAdvanceX, sizeof(rect->GlyphAdvanceX));
+        hash = HashBytes(hash, &rect->GlyphOffset, sizeof(rect->GlyphOffset));
+    }
+
+    return hash;
+}
+
+// not TextFormat, its buffers are shared with the main thread when the atlas is built on a worker
+static void GetFontCachePath(const char* directory, uint64_t key, char* path, size_t size)
+{
+    snprintf(path, size, "%s/rlimgui_fonts_%08x%08x.bin", directory, (unsigned int)(key >> 32), (unsigned int)key);
+}
+
+// writes a built atlas, or only measures it when the stream has no data
+static bool WriteFontCache(FontCacheStream* stream, const ImFontAtlas* atlas, uint64_t key)
+{
+    FontCacheHeader header = { RLIMGUI_FONT_CACHE_MAGIC, RLIMGUI_FONT_CACHE_VERSION, key, atlas->TexWidth, atlas->TexHeight,
+        atlas->Fonts.Size, atlas->CustomRects.Size, atlas->PackIdMouseCursors, atlas->PackIdLines, atlas->TexUvWhitePixel };
+
+    bool ok = FontCacheWrite(stream, &header, sizeof(header));
+    ok = ok && FontCacheWrite(stream, atlas->TexUvLines, sizeof(atlas->TexUvLines));
+
+    for (int i = 0; ok && i < atlas->CustomRects.Size; ++i)
+    {
+        // the font pointer is stored as an index
+        ImFontAtlasCustomRect rect = atlas->CustomRects.Data[i];
+        rect.Font = (ImFont*)(intptr_t)FindFontIndex(atlas, atlas->CustomRects.Data[i].Font);
+        ok = FontCacheWrite(stream, &rect, sizeof(rect));
+    }
+
+    for (int i = 0; ok && i < atlas->Fonts.Size; ++i)
+    {
+        const ImFont* font = atlas->Fonts.Data[i];
+        FontCacheFont fontHeader = { font->FontSize, font->Ascent, font->Descent, font->Glyphs.Size };
+        ok = FontCacheWrite(stream, &fontHeader, sizeof(fontHeader));
+        ok = ok && FontCacheWrite(stream, font->Glyphs.Data, font->Glyphs.Size * (int)sizeof(ImFontGlyph));
+    }
+
+    return ok && FontCacheWrite(stream, atlas->TexPixelsAlpha8, atlas->TexWidth * atlas->TexHeight);
+}
+
+static void SaveFontCache(const ImFontAtlas* atlas, const char* directory, uint64_t key)
+{
+    // color glyphs only exist in the RGBA pixels, those atlases are always built
+    if (atlas->TexPixelsAlpha8 == nullptr || atlas->TexPixelsUseColors)
+        return;
+
+    FontCacheStream stream = { nullptr, INT32_MAX, 0 };
+    WriteFontCache(&stream, atlas, key);
+
+    stream = (FontCacheStream){ (unsigned char*)MemAlloc(stream.Offset), stream.Offset, 0 };
+    char path[sizeof(FontCacheDirectory) + 64];
+    GetFontCachePath(directory, key, path, sizeof(path));
+    if (WriteFontCache(&stream, atlas, key))
+        SaveFileData(path, stream.Data, stream.Size);
+
+    MemFree(stream.Data);
+}
+
+// rebuilds the atlas output from a cache file: glyphs, lookup tables, custom rects and the Alpha8 pixels.
+// Everything is validated before the atlas is touched, so a bad file falls back to a normal build
+static bool LoadFontCache(ImFontAtlas* atlas, const char* directory, uint64_t key)
+{
+    char path[sizeof(FontCacheDirectory) + 64];
+    GetFontCachePath(directory, key, path, sizeof(path));
+
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (data == nullptr)
+        return false;
+
+    FontCacheStream stream = { data, size, 0 };
+    FontCacheHeader header = { 0 };
+    bool ok = FontCacheRead(&stream, &header, sizeof(header));
+    ok = ok && header.Magic == RLIMGUI_FONT_CACHE_MAGIC && header.Version == RLIMGUI_FONT_CACHE_VERSION && header.Key == key;
+    ok = ok && header.FontCount == atlas->Fonts.Size && header.CustomRectCount >= atlas->CustomRects.Size;
+    ok = ok && header.TexWidth > 0 && header.TexHeight > 0;
+
+    int linesOffset = stream.Offset;
+    stream.Offset += (int)sizeof(atlas->TexUvLines) + header.CustomRectCount * (int)sizeof(ImFontAtlasCustomRect);
+    int fontsOffset = stream.Offset;
+    for (int i = 0; ok && i < header.FontCount; ++i)
+    {
+        FontCacheFont fontHeader;
+        ok = FontCacheRead(&stream, &fontHeader, sizeof(fontHeader)) && fontHeader.GlyphCount >= 0;
+        stream.Offset += ok ? fontHeader.GlyphCount * (int)sizeof(ImFontGlyph) : 0;
+    }
+    ok = ok && stream.Offset + header.TexWidth * header.TexHeight == size;
+
+    if (!ok)
+    {
+        UnloadFileData(data);
+        return false;
+    }
+
+    stream.Offset = linesOffset;
+    FontCacheRead(&stream, atlas->TexUvLines, sizeof(atlas->TexUvLines));
+
+    ImFontAtlasCustomRect* rects = (ImFontAtlasCustomRect*)igMemAlloc(header.CustomRectCount * sizeof(ImFontAtlasCustomRect));
+    for (int i = 0; i < header.CustomRectCount; ++i)
+    {
+        FontCacheRead(&stream, rects + i, sizeof(ImFontAtlasCustomRect));
+        int fontIndex = (int)(intptr_t)rects[i].Font;
+        rects[i].Font = (fontIndex >= 0 && fontIndex < atlas->Fonts.Size) ? atlas->Fonts.Data[fontIndex] : nullptr;
+    }
+    if (atlas->CustomRects.Data != nullptr)
+        igMemFree(atlas->CustomRects.Data);
+    atlas->CustomRects = (ImVector_ImFontAtlasCustomRect){ header.CustomRectCount, header.CustomRectCount, rects };
+    atlas->PackIdMouseCursors = header.PackIdMouseCursors;
+    atlas->PackIdLines = header.PackIdLines;
+
+    stream.Offset = fontsOffset;
+    for (int i = 0; i < header.FontCount; ++i)
+    {
+        ImFont* font = atlas->Fonts.Data[i];
+        FontCacheFont fontHeader;
+        FontCacheRead(&stream, &fontHeader, sizeof(fontHeader));
+
+        ImFont_ClearOutputData(font);
+        font->FontSize = fontHeader.FontSize;
+        font->Ascent = fontHeader.Ascent;
+        font->Descent = fontHeader.Descent;
+        font->ContainerAtlas = atlas;
+
+        // the stored glyphs already have the config adjustments applied, so no config is passed in
+        for (int g = 0; g < fontHeader.GlyphCount; ++g)
+        {
+            ImFontGlyph glyph;
+            FontCacheRead(&stream, &glyph, sizeof(glyph));
+            ImFont_AddGlyph(font, nullptr, (ImWchar)glyph.Codepoint, glyph.X0, glyph.Y0, glyph.X1, glyph.Y1, glyph.U0, glyph.V0, glyph.U1, glyph.V1, glyph.AdvanceX);
+            font->Glyphs.Data[font->Glyphs.Size - 1].Visible = glyph.Visible;
+        }
+
+        ImFont_BuildLookupTable(font);
+    }
+
+    int pixelCount = header.TexWidth * header.TexHeight;
+    atlas->TexPixelsAlpha8 = (unsigned char*)igMemAlloc(pixelCount);
+    FontCacheRead(&stream, atlas->TexPixelsAlpha8, pixelCount);
+    atlas->TexWidth = header.TexWidth;
+    atlas->TexHeight = header.TexHeight;
+    atlas->TexUvScale = (ImVec2){ 1.0f / header.TexWidth, 1.0f / header.TexHeight };
+    atlas->TexUvWhitePixel = header.TexUvWhitePixel;
+    atlas->TexReady = true;
+
+    UnloadFileData(data);
+    return true;
+}
+
+// one bit per codepoint ImWchar can hold
+#define RLIMGUI_GLYPH_PROFILE_BYTES ((sizeof(ImWchar) == 2 ? 0x10000 : 0x110000) / 8)
+
+typedef struct
+{
+    uint64_t Key;               // U0 and V0 of the glyph
+    unsigned int Codepoint;     // 0 for an empty slot
+} GlyphLookupEntry;
+
+typedef struct
+{
+    bool Recording;
+    unsigned char* Used;        // the codepoints drawn while recording
+    unsigned char* Loaded;      // the profile fonts are built from, NULL to build the full ranges
+
+    // finds the glyph a quad was drawn with from its texture coordinates
+    GlyphLookupEntry* Lookup;
+    int LookupSize;
+    const ImFontAtlas* LookupAtlas;
+    ImTextureID LookupTexture;
+    int LookupGlyphs;
+} GlyphProfiler;
+
+static GlyphProfiler GlyphProfile = { 0 };
+
+static void SetCodepointBit(unsigned char* bits, unsigned int codepoint)
+{
+    if (codepoint < RLIMGUI_GLYPH_PROFILE_BYTES * 8)
+        bits[codepoint >> 3] |= (unsigned char)(1 << (codepoint & 7));
+}
+
+static bool GetCodepointBit(const unsigned char* bits, unsigned int codepoint)
+{
+    return (bits[codepoint >> 3] & (1 << (codepoint & 7))) != 0;
+}
+
+// characters ImGui uses without drawing them from text: spaces and tabs are never drawn, the fallback and ellipsis
+// characters only when text doesn't fit or a glyph is missing. A profile always keeps them, with ASCII.
+static void AddRequiredCodepoints(unsigned char* bits)
+{
+    static const unsigned int required[] = { 0x09, 0x0A, 0x85, 0x2026, 0xFFFD };
+
+    for (unsigned int codepoint = 0x20; codepoint < 0x7F; ++codepoint)
+        SetCodepointBit(bits, codepoint);
+    for (int i = 0; i < (int)(sizeof(required) / sizeof(required[0])); ++i)
+        SetCodepointBit(bits, required[i]);
+}
+
+// writes the set bits as ImWchar ranges with a 0 terminator, returns the number of ranges. Counts only when ranges is NULL.
+static int GetCodepointRanges(const unsigned char* bits, ImWchar* ranges)
+{
+    int count = 0;
+    unsigned int first = 0;
+    bool inRange = false;
+
+    for (unsigned int codepoint = 0; codepoint <= RLIMGUI_GLYPH_PROFILE_BYTES * 8; ++codepoint)
+    {
+        // whole bytes without a glyph are skipped
+        if (!inRange && (codepoint & 7) == 0 && codepoint < RLIMGUI_GLYPH_PROFILE_BYTES * 8 && bits[codepoint >> 3] == 0)
+        {
+            codepoint += 7;
+            continue;
+        }
+
+        bool used = codepoint < RLIMGUI_GLYPH_PROFILE_BYTES * 8 && GetCodepointBit(bits, codepoint);
+        if (used && !inRange)
+        {
+            first = codepoint;
+            inRange = true;
+        }
+        else if (!used && inRange)
+        {
+            if (ranges != nullptr)
+            {
+                ranges[count * 2] = (ImWchar)first;
+                ranges[count * 2 + 1] = (ImWchar)(codepoint - 1);
+            }
+            count++;
+            inRange = false;
+        }
+    }
+
+    if (ranges != nullptr)
+        ranges[count * 2] = 0;
+    return count;
+}
+
+// reads the next number of a profile file, skipping separators and comments
+static bool ReadProfileNumber(const char** cursor, unsigned long* value)
+{
+    const char* text = *cursor;
+    while (*text != 0 && (*text < '0' || *text > '9'))
+    {
+        if (text[0] == '/' && text[1] == '/')
+        {
+            while (*text != 0 && *text != '\n')
+                text++;
+        }
+        else
+        {
+            text++;
+        }
+    }
+
+    if (*text == 0)
+        return false;
+
+    char* end = nullptr;
+    *value = strtoul(text, &end, 0);
+    *cursor = end;
+    return true;
+}
+
+static uint64_t GetGlyphLookupKey(float u, float v)
+{
+    unsigned int bits[2];
+    memcpy(bits + 0, &u, sizeof(float));
+    memcpy(bits + 1, &v, sizeof(float));
+    return ((uint64_t)bits[0] << 32) | bits[1];
+}
+
+static int GetGlyphLookupSlot(uint64_t key)
+{
+    return (int)((key * 0x9E3779B97F4A7C15ull) >> 32) & (GlyphProfile.LookupSize - 1);
+}
+
+// maps the top left texture coordinate of every visible glyph in the atlas to its codepoint, ImGui draws each glyph
+// as a quad that starts at that corner
+static void BuildGlyphLookup(const ImFontAtlas* atlas, int glyphCount)
+{
+    int size = 64;
+    while (size < glyphCount * 2)
+        size *= 2;
+
+    if (size > GlyphProfile.LookupSize)
+    {
+        MemFree(GlyphProfile.Lookup);
+        GlyphProfile.Lookup = (GlyphLookupEntry*)MemAlloc(sizeof(GlyphLookupEntry) * size);
+        GlyphProfile.LookupSize = size;
+    }
+    memset(GlyphProfile.Lookup, 0, sizeof(GlyphLookupEntry) * GlyphProfile.LookupSize);
+
+    for (int f = 0; f < atlas->Fonts.Size; ++f)
+    {
+        const ImFont* font = atlas->Fonts.Data[f];
+        for (int g = 0; g < font->Glyphs.Size; ++g)
+        {
+            const ImFontGlyph* glyph = font->Glyphs.Data + g;
+            if (!glyph->Visible || glyph->Codepoint == 0)
+                continue;
+
+            uint64_t key = GetGlyphLookupKey(glyph->U0, glyph->V0);
+            int slot = GetGlyphLookupSlot(key);
+            while (GlyphProfile.Lookup[slot].Codepoint != 0 && GlyphProfile.Lookup[slot].Key != key)
+                slot = (slot + 1) & (GlyphProfile.LookupSize - 1);
+
+            GlyphProfile.Lookup[slot].Key = key;
+            GlyphProfile.Lookup[slot].Codepoint = glyph->Codepoint;
+        }
+    }
+
+    GlyphProfile.LookupAtlas = atlas;
+    GlyphProfile.LookupTexture = atlas->TexID;
+    GlyphProfile.LookupGlyphs = glyphCount;
+}
+
+static unsigned int FindGlyphCodepoint(ImVec2 uv)
+{
+    uint64_t key = GetGlyphLookupKey(uv.x, uv.y);
+    for (int slot = GetGlyphLookupSlot(key); GlyphProfile.Lookup[slot].Codepoint != 0; slot = (slot + 1) & (GlyphProfile.LookupSize - 1))
+    {
+        if (GlyphProfile.Lookup[slot].Key == key)
+            return GlyphProfile.Lookup[slot].Codepoint;
+    }
+    return 0;
+}
+
+// marks the codepoints of the glyphs in the font texture commands. Every vertex is looked up, shapes drawn with the
+// white pixel and the other corners of glyph quads don't match a glyph.
+static void RecordGlyphs(const ImDrawData* draw_data)
+{
+    // the fonts of the context being drawn, rlImGuiRenderContext draws while another ImGui context can be current
+    const ImFontAtlas* atlas = (CurrentContext->ImGui != nullptr) ? CurrentContext->ImGui->IO.Fonts : igGetIO()->Fonts;
+    if (atlas->TexID == 0)
+        return;
+
+    int glyphCount = 0;
+    for (int f = 0; f < atlas->Fonts.Size; ++f)
+        glyphCount += atlas->Fonts.Data[f]->Glyphs.Size;
+
+    if (GlyphProfile.LookupAtlas != atlas || GlyphProfile.LookupTexture != atlas->TexID || GlyphProfile.LookupGlyphs != glyphCount)
+        BuildGlyphLookup(atlas, glyphCount);
+
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+        for (int c = 0; c < commandList->CmdBuffer.Size; ++c)
+        {
+            const ImDrawCmd* cmd = commandList->CmdBuffer.Data + c;
+            if (cmd->UserCallback != nullptr || GetCommandTextureId(cmd) != atlas->TexID)
+                continue;
+
+            const ImDrawIdx* indices = commandList->IdxBuffer.Data + cmd->IdxOffset;
+            const ImDrawVert* vertices = commandList->VtxBuffer.Data + cmd->VtxOffset;
+            for (unsigned int i = 0; i < cmd->ElemCount; ++i)
+            {
+                unsigned int codepoint = FindGlyphCodepoint(vertices[indices[i]].uv);
+                if (codepoint != 0)
+                    SetCodepointBit(GlyphProfile.Used, codepoint);
+            }
+        }
+    }
+}
+
+// restricts the glyph ranges of every font to the loaded profile while the atlas is built. The configs get their own
+// ranges back afterwards, so a later build with another profile starts from the full ranges again.
+// Returns the ranges to restore, the original and the profiled ranges of each config.
+static const ImWchar** ApplyGlyphProfile(ImFontAtlas* atlas, const unsigned char* profile)
+{
+    if (profile == nullptr || atlas->ConfigData.Size == 0)
+        return nullptr;
+
+    const ImWchar** restore = (const ImWchar**)MemAlloc(sizeof(ImWchar*) * atlas->ConfigData.Size * 2);
+    unsigned char* bits = (unsigned char*)MemAlloc(RLIMGUI_GLYPH_PROFILE_BYTES);
+
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        ImFontConfig* config = atlas->ConfigData.Data + i;
+        const ImWchar* ranges = (config->GlyphRanges != nullptr) ? config->GlyphRanges : ImFontAtlas_GetGlyphRangesDefault(atlas);
+        restore[i * 2] = config->GlyphRanges;
+        restore[i * 2 + 1] = nullptr;
+
+        memset(bits, 0, RLIMGUI_GLYPH_PROFILE_BYTES);
+        for (const ImWchar* range = ranges; range[0] != 0 && range[1] != 0; range += 2)
+        {
+            for (unsigned int codepoint = range[0]; codepoint <= range[1] && codepoint < RLIMGUI_GLYPH_PROFILE_BYTES * 8; ++codepoint)
+            {
+                if (GetCodepointBit(profile, codepoint))
+                    SetCodepointBit(bits, codepoint);
+            }
+        }
+
+        // a font nothing was drawn with keeps its ranges, ImGui needs at least one glyph in each font
+        int count = GetCodepointRanges(bits, nullptr);
+        if (count == 0 && !config->MergeMode)
+            continue;
+
+        ImWchar* profiled = (ImWchar*)MemAlloc(sizeof(ImWchar) * (count * 2 + 1));
+        GetCodepointRanges(bits, profiled);
+        config->GlyphRanges = profiled;
+        restore[i * 2 + 1] = profiled;
+    }
+
+    MemFree(bits);
+    return restore;
+}
+
+static void RestoreGlyphRanges(ImFontAtlas* atlas, const ImWchar** restore)
+{
+    if (restore == nullptr)
+        return;
+
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        if (restore[i * 2 + 1] == nullptr)
+            continue;
+
+        atlas->ConfigData.Data[i].GlyphRanges = restore[i * 2];
+        MemFree((void*)restore[i * 2 + 1]);
+    }
+    MemFree((void*)restore);
+}
+
+// builds the atlas if it has no pixels yet, from the cache when there is a matching file.
+// Only uses its arguments and the file system, so it can run on a worker thread
+static void BuildFontAtlas(ImFontAtlas* atlas, const unsigned char* profile, const char* cacheDirectory)
+{
+    if (atlas->TexPixelsAlpha8 != nullptr || atlas->TexPixelsRGBA32 != nullptr)
+        return;
+
+    // the profiled ranges are part of the cache key
+    const ImWchar** restore = ApplyGlyphProfile(atlas, profile);
+
+    uint64_t key = 0;
+    bool cached = cacheDirectory[0] != 0 && atlas->Fonts.Size > 0;
+    if (cached)
+        key = GetFontAtlasKey(atlas);
+
+    if (!(cached && LoadFontCache(atlas, cacheDirectory, key)) && ImFontAtlas_Build(atlas) && cached)
+        SaveFontCache(atlas, cacheDirectory, key);
+
+    RestoreGlyphRanges(atlas, restore);
+}
+
+// uploads the atlas straight from ImGui's pixel buffer, as one alpha byte per texel when the alpha shader is available
+static Texture2D LoadFontTexture(ImFontAtlas* atlas)
+{
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    Texture2D texture = { 0 };
+
+#ifndef RLIMGUI_FONT_TEXTURE_RGBA
+    if (AlphaTextures.TextureCount < RLIMGUI_MAX_ALPHA_TEXTURES && LoadAlphaShader())
+    {
+        ImFontAtlas_GetTexDataAsAlpha8(atlas, &pixels, &width, &height, nullptr);
+        texture.id = rlLoadTexture(pixels, width, height, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, 1);
+        texture.format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+    }
+#endif
+
+    if (texture.id != 0)
+    {
+        AlphaTextures.TextureIds[AlphaTextures.TextureCount++] = texture.id;
+    }
+    else
+    {
+        ImFontAtlas_GetTexDataAsRGBA32(atlas, &pixels, &width, &height, nullptr);
+        texture.id = rlLoadTexture(pixels, width, height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+        texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+    }
+
+    texture.width = width;
+    texture.height = height;
+    texture.mipmaps = 1;
+    return texture;
+}
+
+static void UnloadFontTexture(ImFontAtlas* atlas)
+{
+    Texture2D* fontTexture = (Texture2D*)atlas->TexID;
+    if (fontTexture)
+    {
+        RemoveAlphaTexture(fontTexture->id);
+        UnloadTexture(*fontTexture);
+        MemFree(fontTexture);
+    }
+
+    atlas->TexID = 0;
+}
+
+void ReloadFonts(void)
+{
+    ImGuiIO* io = igGetIO();
+
+    UnloadFontTexture(io->Fonts);
+    BuildFontAtlas(io->Fonts, GlyphProfile.Loaded, FontCacheDirectory);
+
+    Texture2D* fontTexture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+    *fontTexture = LoadFontTexture(io->Fonts);
+    io->Fonts->TexID = (ImTextureID)fontTexture;
+}
+
+#else
+
+// Textures ImGui asks the backend for. A font atlas starts small and grows, new glyphs only upload the rects
+// ImGui marks as dirty instead of the whole atlas
+static unsigned char* TextureUploadBuffer = nullptr;
+static int TextureUploadCapacity = 0;
+
+// UpdateTextureRec takes tightly packed pixels in the texture format, so the rect rows are copied out of the ImGui pixels.
+// pixels points at the top left of the rect, pitch is the size of a source row in bytes
+static void UploadTextureRect(const Texture2D* texture, const unsigned char* pixels, int pitch, int bytesPerPixel, int x, int y, int width, int height)
+{
+    int texelSize = (texture->format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) ? 1 : 4;
+    int size = width * height * texelSize;
+    if (size > TextureUploadCapacity)
+    {
+        TextureUploadBuffer = (unsigned char*)MemRealloc(TextureUploadBuffer, size);
+        TextureUploadCapacity = size;
+    }
+
+    for (int row = 0; row < height; ++row)
+    {
+        const unsigned char* source = pixels + row * pitch;
+        unsigned char* dest = TextureUploadBuffer + row * width * texelSize;
+
+        if (bytesPerPixel == texelSize)
+        {
+            memcpy(dest, source, width * texelSize);
+            continue;
+        }
+
+        // Alpha8 pixels for a texture that had to be created as RGBA
+        for (int i = 0; i < width; ++i)
+        {
+            dest[i * 4 + 0] = 255;
+            dest[i * 4 + 1] = 255;
+            dest[i * 4 + 2] = 255;
+            dest[i * 4 + 3] = source[i];
+        }
+    }
+
+    UpdateTextureRec(*texture, (Rectangle){ (float)x, (float)y, (float)width, (float)height }, TextureUploadBuffer);
+    CurrentContext->FrameStats.TextureUploads++;
+}
+
+// Alpha8 textures are kept at one byte per texel when the alpha shader is available, like prebaked font atlases
+static void LoadTextureData(Texture2D* texture, const unsigned char* pixels, int width, int height, ImTextureFormat format)
+{
+    int bytesPerPixel = (format == ImTextureFormat_Alpha8) ? 1 : 4;
+    bool alpha = false;
+#ifndef RLIMGUI_FONT_TEXTURE_RGBA
+    alpha = bytesPerPixel == 1 && AlphaTextures.TextureCount < RLIMGUI_MAX_ALPHA_TEXTURES && LoadAlphaShader();
+#endif
+
+    texture->width = width;
+    texture->height = height;
+    texture->mipmaps = 1;
+    texture->format = alpha ? PIXELFORMAT_UNCOMPRESSED_GRAYSCALE : PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    // pixels already in the texture format are uploaded with the texture, Alpha8 pixels for an RGBA texture are expanded
+    bool direct = alpha || bytesPerPixel == 4;
+    texture->id = rlLoadTexture(direct ? pixels : nullptr, width, height, texture->format, 1);
+
+    if (alpha)
+        AlphaTextures.TextureIds[AlphaTextures.TextureCount++] = texture->id;
+
+    if (direct)
+        CurrentContext->FrameStats.TextureUploads++;
+    else
+        UploadTextureRect(texture, pixels, width * bytesPerPixel, bytesPerPixel, 0, 0, width, height);
+}
+
+static void UnloadTextureData(Texture2D* texture)
+{
+    RemoveAlphaTexture(texture->id);
+    UnloadTexture(*texture);
+    MemFree(texture);
+}
+
+static void CreateTexture(ImTextureData* tex)
+{
+    Texture2D* texture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+    LoadTextureData(texture, (const unsigned char*)ImTextureData_GetPixels(tex), tex->Width, tex->Height, tex->Format);
+
+    ImTextureData_SetTexID(tex, (ImTextureID)(uintptr_t)texture);
+    ImTextureData_SetStatus(tex, ImTextureStatus_OK);
+}
+
+static void UpdateTexture(ImTextureData* tex)
+{
+    const Texture2D* texture = (const Texture2D*)(uintptr_t)tex->TexID;
+    for (int i = 0; i < tex->Updates.Size; ++i)
+    {
+        const ImTextureRect* rect = &tex->Updates.Data[i];
+        const unsigned char* pixels = (const unsigned char*)ImTextureData_GetPixelsAt(tex, rect->x, rect->y);
+        UploadTextureRect(texture, pixels, tex->Width * tex->BytesPerPixel, tex->BytesPerPixel, rect->x, rect->y, rect->w, rect->h);
+    }
+
+    ImTextureData_SetStatus(tex, ImTextureStatus_OK);
+}
+
+static void DestroyTexture(ImTextureData* tex)
+{
+    Texture2D* texture = (Texture2D*)(uintptr_t)tex->TexID;
+    if (texture != nullptr)
+        UnloadTextureData(texture);
+
+    ImTextureData_SetTexID(tex, 0);
+    ImTextureData_SetStatus(tex, ImTextureStatus_Destroyed);
+}
+
+// handles the requests of every texture in the frame before anything is drawn with them
+static void UpdateTextures(const ImDrawData* draw_data)
+{
+    if (draw_data->Textures == nullptr)
+        return;
+
+    bool changed = false;
+    for (int i = 0; i < draw_data->Textures->Size; ++i)
+    {
+        ImTextureData* tex = draw_data->Textures->Data[i];
+
+        if (tex->Status == ImTextureStatus_WantCreate)
+            CreateTexture(tex);
+        else if (tex->Status == ImTextureStatus_WantUpdates)
+            UpdateTexture(tex);
+        // a texture is only destroyed once no frame used it, a delayed frame may still draw with it
+        else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+            DestroyTexture(tex);
+        else
+            continue;
+
+        changed = true;
+    }
+
+    // the cached frame was drawn with the old texture contents
+    if (changed)
+        CurrentContext->FrameCache.Valid = false;
+}
+
+// textures of a shared atlas are only destroyed by the last context using it
+static void DestroyTextures(void)
+{
+    ImGuiPlatformIO* platformIO = igGetPlatformIO();
+    for (int i = 0; i < platformIO->Textures.Size; ++i)
+    {
+        ImTextureData* tex = platformIO->Textures.Data[i];
+        if (tex->RefCount == 1 && tex->TexID != 0)
+            DestroyTexture(tex);
+    }
+}
+
+static void UnloadTextureUploadBuffer(void)
+{
+    MemFree(TextureUploadBuffer);
+    TextureUploadBuffer = nullptr;
+    TextureUploadCapacity = 0;
+}
+
+// nothing to rebuild, the atlas textures follow the fonts through UpdateTextures and new fonts are rasterized when used
+void ReloadFonts(void)
+{
+}
+
+#endif
+
+#ifndef NO_FONT_AWESOME
+// Font Awesome glyph ranges set by rlImGuiSetFontAwesomeCodepoints, the whole ICON_MIN_FA..ICON_MAX_FA range when not set
+static ImWchar* FontAwesomeRanges = nullptr;
+
+// ranges replaced by a later call. Font configs of atlases that are still alive point to them, and are read again when
+// those atlases are rebuilt, hashed for the cache or cloned for another scale, so they are never freed
+static ImWchar** RetiredFontAwesomeRanges = nullptr;
+static int RetiredFontAwesomeRangeCount = 0;
+
+static int CompareCodepoints(const void* a, const void* b)
+{
+    return *(const int*)a - *(const int*)b;
+}
+#endif
+
+// the Font Awesome ranges to load, only called on the main thread. Builds on a worker get the result,
+// the pointer stays valid because replaced ranges are never freed
+static const ImWchar* GetFontAwesomeRanges(void)
+{
+#ifndef NO_FONT_AWESOME
+    static const ImWchar all_ranges[] = { ICON_MIN_FA, ICON_MAX_FA, 0 };
+
+#if defined(RLIMGUI_FONT_AWESOME_SUBSET)
+    if (FontAwesomeRanges == nullptr)
+        rlImGuiSetFontAwesomeCodepoints(FontAwesomeSubsetCodepoints, FONT_AWESOME_SUBSET_COUNT);
+#endif
+
+    return (FontAwesomeRanges != nullptr) ? FontAwesomeRanges : all_ranges;
+#else
+    return nullptr;
+#endif
+}
+
+static void AddFontAwesome(ImFontAtlas* atlas, const ImWchar* icons_ranges)
+{
+#ifndef NO_FONT_AWESOME
+    // a subset without any icons
+    if (icons_ranges[0] == 0)
+        return;
+
+    ImFontConfig* icons_config = ImFontConfig_ImFontConfig();
+    icons_config->MergeMode = true;
+    icons_config->PixelSnapH = true;
+    icons_config->FontDataOwnedByAtlas = false;
+
+    icons_config->GlyphMaxAdvanceX = FLT_MAX;
+    icons_config->RasterizerMultiply = 1.0f;
+    icons_config->OversampleH = 2;
+    icons_config->OversampleV = 1;
+
+    icons_config->GlyphRanges = icons_ranges;
+
+    ImFontAtlas_AddFontFromMemoryCompressedTTF(atlas, (void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, FONT_AWESOME_ICON_SIZE, icons_config, icons_ranges);
+    ImFontConfig_destroy(icons_config);
+#endif
+}
+
+// the fonts rlImGuiSetup loads, for atlases built without a setup callback. The user data is the result of GetFontAwesomeRanges
+static void AddDefaultFonts(ImFontAtlas* atlas, void* userData)
+{
+    ImFontAtlas_AddFontDefault(atlas, nullptr);
+    AddFontAwesome(atlas, (const ImWchar*)userData);
+}
+
+#ifndef NO_FONT_AWESOME
+
+// the decompressed Font Awesome TTF the icons are rasterized from, shared by every context
+static unsigned char* IconFontData = nullptr;
+static int IconFontDataSize = 0;
+
+// ImGui only exposes its decompressor through AddFontFromMemoryCompressedTTF, so the font is added to a throwaway atlas
+// and the TTF data copied out of its config
+static bool LoadIconFontData(void)
+{
+    if (IconFontData != nullptr)
+        return true;
+
+    ImFontAtlas* atlas = ImFontAtlas_ImFontAtlas();
+    ImFontAtlas_AddFontFromMemoryCompressedTTF(atlas, (void*)fa_solid_900_compressed_data, fa_solid_900_compressed_size, FONT_AWESOME_ICON_SIZE, nullptr, nullptr);
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    const ImVector_ImFontConfig* configs = &atlas->Sources;
+#else
+    const ImVector_ImFontConfig* configs = &atlas->ConfigData;
+#endif
+    if (configs->Size > 0)
+    {
+        IconFontDataSize = configs->Data[0].FontDataSize;
+        IconFontData = (unsigned char*)MemAlloc(IconFontDataSize);
+        memcpy(IconFontData, configs->Data[0].FontData, IconFontDataSize);
+    }
+
+    ImFontAtlas_destroy(atlas);
+    return IconFontData != nullptr;
+}
+
+static void UnloadIconFontData(void)
+{
+    MemFree(IconFontData);
+    IconFontData = nullptr;
+    IconFontDataSize = 0;
+}
+
+static void LoadIconPage(IconPage* page)
+{
+    *page = (IconPage){ 0 };
+
+    // same formats as the font texture, one alpha byte per texel when the alpha shader is available
+    unsigned char* pixels = (unsigned char*)MemAlloc(RLIMGUI_ICON_PAGE_SIZE * RLIMGUI_ICON_PAGE_SIZE * 4);
+    int format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+#ifndef RLIMGUI_FONT_TEXTURE_RGBA
+    if (AlphaTextures.TextureCount < RLIMGUI_MAX_ALPHA_TEXTURES && LoadAlphaShader())
+        format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+#endif
+
+    page->Texture.id = rlLoadTexture(pixels, RLIMGUI_ICON_PAGE_SIZE, RLIMGUI_ICON_PAGE_SIZE, format, 1);
+    page->Texture.width = RLIMGUI_ICON_PAGE_SIZE;
+    page->Texture.height = RLIMGUI_ICON_PAGE_SIZE;
+    page->Texture.mipmaps = 1;
+    page->Texture.format = format;
+    MemFree(pixels);
+
+    if (format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE && page->Texture.id != 0)
+        AlphaTextures.TextureIds[AlphaTextures.TextureCount++] = page->Texture.id;
+    SetTextureFilter(page->Texture, TEXTURE_FILTER_BILINEAR);
+}
+
+static void ClearIconPage(int pageIndex)
+{
+    IconAtlasState* icons = &CurrentContext->IconAtlas;
+    IconPage* page = icons->Pages + pageIndex;
+    page->ShelfX = 0;
+    page->ShelfY = 0;
+    page->ShelfHeight = 0;
+
+    int kept = 0;
+    for (int i = 0; i < icons->GlyphCount; ++i)
+    {
+        if (icons->Glyphs[i].Page != pageIndex)
+            icons->Glyphs[kept++] = icons->Glyphs[i];
+    }
+    icons->GlyphCount = kept;
+}
+
+static void UnloadIconAtlas(void)
+{
+    IconAtlasState* icons = &CurrentContext->IconAtlas;
+    for (int i = 0; i < icons->PageCount; ++i)
+    {
+        RemoveAlphaTexture(icons->Pages[i].Texture.id);
+        UnloadTexture(icons->Pages[i].Texture);
+    }
+
+    MemFree(icons->Glyphs);
+    *icons = (IconAtlasState){ 0 };
+}
+
+// packs a rect into the shelves of a page, a new shelf is started when the current one is full
+static bool PackIconRect(IconPage* page, int width, int height, int* x, int* y)
+{
+    if (page->ShelfX + width > RLIMGUI_ICON_PAGE_SIZE)
+    {
+        page->ShelfY += page->ShelfHeight;
+        page->ShelfX = 0;
+        page->ShelfHeight = 0;
+    }
+
+    if (page->ShelfY + height > RLIMGUI_ICON_PAGE_SIZE)
+        return false;
+
+    *x = page->ShelfX;
+    *y = page->ShelfY;
+    page->ShelfX += width;
+    if (height > page->ShelfHeight)
+        page->ShelfHeight = height;
+    return true;
+}
+
+// finds room for a glyph in the current page, then in a new page, then in the least recently used page
+static int ReserveIconRect(int width, int height, int* x, int* y)
+{
+    IconAtlasState* icons = &CurrentContext->IconAtlas;
+    if (icons->PageCount > 0 && PackIconRect(icons->Pages + icons->CurrentPage, width, height, x, y))
+        return icons->CurrentPage;
+
+    if (icons->PageCount < RLIMGUI_MAX_ICON_PAGES)
+    {
+        LoadIconPage(icons->Pages + icons->PageCount);
+        if (icons->Pages[icons->PageCount].Texture.id == 0)
+            return -1;
+
+        icons->CurrentPage = icons->PageCount++;
+        return PackIconRect(icons->Pages + icons->CurrentPage, width, height, x, y) ? icons->CurrentPage : -1;
+    }
+
+    int oldest = -1;
+    for (int i = 0; i < icons->PageCount; ++i)
+    {
+        if (icons->Pages[i].LastUsed + RLIMGUI_ICON_PAGE_KEEP_FRAMES >= icons->Frame)
+            continue;
+        if (oldest < 0 || icons->Pages[i].LastUsed < icons->Pages[oldest].LastUsed)
+            oldest = i;
+    }
+    if (oldest < 0)
+        return -1;
+
+    // the cleared page is filled up next. Pages keep their slot, the texture id ImGui was given points into it.
+    ClearIconPage(oldest);
+    icons->CurrentPage = oldest;
+    return PackIconRect(icons->Pages + icons->CurrentPage, width, height, x, y) ? icons->CurrentPage : -1;
+}
+
+// rasterizes a glyph with one texel of empty border, so filtering never reads the neighbouring glyphs
+static const IconGlyph* RasterizeIcon(int codepoint, int pixelSize)
+{
+    if (!LoadIconFontData())
+        return nullptr;
+
+    GlyphInfo* info = LoadFontData(IconFontData, IconFontDataSize, pixelSize, &codepoint, 1, FONT_DEFAULT);
+    if (info == nullptr)
+        return nullptr;
+
+    IconAtlasState* icons = &CurrentContext->IconAtlas;
+    Image image = info[0].image;
+    int width = image.width + 2;
+    int height = image.height + 2;
+    int x = 0, y = 0;
+    int pageIndex = (image.data != nullptr && width <= RLIMGUI_ICON_PAGE_SIZE && height <= RLIMGUI_ICON_PAGE_SIZE) ? ReserveIconRect(width, height, &x, &y) : -1;
+
+    if (pageIndex >= 0)
+    {
+        const Texture2D* texture = &icons->Pages[pageIndex].Texture;
+        int bytesPerPixel = (texture->format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) ? 1 : 4;
+        unsigned char* pixels = (unsigned char*)MemAlloc(width * height * bytesPerPixel);
+
+        const unsigned char* coverage = (const unsigned char*)image.data;
+        for (int row = 0; row < image.height; ++row)
+        {
+            for (int column = 0; column < image.width; ++column)
+            {
+                unsigned char alpha = coverage[row * image.width + column];
+                unsigned char* texel = pixels + ((row + 1) * width + column + 1) * bytesPerPixel;
+                if (bytesPerPixel == 1)
+                {
+                    texel[0] = alpha;
+                }
+                else
+                {
+                    texel[0] = texel[1] = texel[2] = 255;
+                    texel[3] = alpha;
+                }
+            }
+        }
+
+        UpdateTextureRec(*texture, (Rectangle){ (float)x, (float)y, (float)width, (float)height }, pixels);
+        MemFree(pixels);
+
+        if (icons->GlyphCount == icons->GlyphCapacity)
+        {
+            icons->GlyphCapacity = (icons->GlyphCapacity == 0) ? 64 : icons->GlyphCapacity * 2;
+            icons->Glyphs = (IconGlyph*)MemRealloc(icons->Glyphs, sizeof(IconGlyph) * icons->GlyphCapacity);
+        }
+
+        icons->Glyphs[icons->GlyphCount++] = (IconGlyph){
+            codepoint, pixelSize, pageIndex,
+            (Rectangle){ (float)x + 1, (float)y + 1, (float)image.width, (float)image.height },
+            (Vector2){ (float)info[0].offsetX, (float)info[0].offsetY },
+            (float)info[0].advanceX
+        };
+    }
+
+    UnloadFontData(info, 1);
+    return (pageIndex >= 0) ? icons->Glyphs + icons->GlyphCount - 1 : nullptr;
+}
+
+static const IconGlyph* GetIconGlyph(int codepoint, int pixelSize)
+{
+    IconAtlasState* icons = &CurrentContext->IconAtlas;
+    for (int i = 0; i < icons->GlyphCount; ++i)
+    {
+        if (icons->Glyphs[i].Codepoint == codepoint && icons->Glyphs[i].PixelSize == pixelSize)
+            return icons->Glyphs + i;
+    }
+
+    return RasterizeIcon(codepoint, pixelSize);
+}
+
+#endif
+
+// Font files added with rlImGuiAddFontFile. Each file is mapped into memory once and shared by every size and context
+// that uses it, the atlases only point to the mapping. The OS loads the pages of the file when glyphs are rasterized,
+// an atlas loaded from the font cache only reads the table directory at the start of the file.
+typedef struct
+{
+    char* Path;
+    unsigned char* Data;
+    int Size;
+    bool Mapped;            // false when the file couldn't be mapped and was read instead
+    uint64_t FileId;        // device and inode, to find a file opened through another path. 0 when unknown
+} FontFile;
+
+typedef struct
+{
+    FontFile* Files;
+    int Count;
+    int Capacity;
+} FontFileRegistry;
+
+static FontFileRegistry FontFiles = { 0 };
+
+static uint64_t GetFontFileId(const char* path)
+{
+#if !defined(_WIN32) && !defined(PLATFORM_WEB)
+    struct stat info;
+    if (stat(path, &info) == 0)
+        return ((uint64_t)info.st_dev << 40) ^ (uint64_t)info.st_ino;
+#endif
+    return 0;
+}
+
+static bool MapFontFile(const char* path, FontFile* file)
+{
+#if defined(_WIN32)
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size = { 0 };
+    if (GetFileSizeEx(handle, &size) && size.QuadPart > 0 && size.QuadPart < INT32_MAX)
+    {
+        // the view keeps the mapping open
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+        {
+            file->Data = (unsigned char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            file->Size = (int)size.QuadPart;
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(handle);
+#elif !defined(PLATFORM_WEB)
+    int descriptor = open(path, O_RDONLY);
+    if (descriptor < 0)
+        return false;
+
+    struct stat info;
+    if (fstat(descriptor, &info) == 0 && info.st_size > 0 && info.st_size < INT32_MAX)
+    {
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (data != MAP_FAILED)
+        {
+            file->Data = (unsigned char*)data;
+            file->Size = (int)info.st_size;
+        }
+    }
+    close(descriptor);
+#endif
+
+    file->Mapped = file->Data != nullptr;
+    return file->Mapped;
+}
+
+static void UnmapFontFile(FontFile* file)
+{
+    if (!file->Mapped)
+    {
+        UnloadFileData(file->Data);
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(file->Data);
+#elif !defined(PLATFORM_WEB)
+    munmap(file->Data, (size_t)file->Size);
+#endif
+}
+
+// the same file is only mapped once, whatever path it is opened through
+static const FontFile* GetFontFile(const char* path)
+{
+    uint64_t fileId = GetFontFileId(path);
+    for (int i = 0; i < FontFiles.Count; ++i)
+    {
+        const FontFile* file = FontFiles.Files + i;
+        if (strcmp(file->Path, path) == 0 || (fileId != 0 && file->FileId == fileId))
+            return file;
+    }
+
+    FontFile file = { nullptr, nullptr, 0, false, fileId };
+    if (!MapFontFile(path, &file))
+    {
+        // platforms without file mapping still share one copy of the file
+        file.Data = LoadFileData(path, &file.Size);
+        if (file.Data == nullptr)
+            return nullptr;
+    }
+
+    file.Path = (char*)MemAlloc((unsigned int)strlen(path) + 1);
+    strcpy(file.Path, path);
+
+    if (FontFiles.Count == FontFiles.Capacity)
+    {
+        FontFiles.Capacity = (FontFiles.Capacity == 0) ? 8 : FontFiles.Capacity * 2;
+        FontFiles.Files = (FontFile*)MemRealloc(FontFiles.Files, sizeof(FontFile) * FontFiles.Capacity);
+    }
+    FontFiles.Files[FontFiles.Count++] = file;
+    return FontFiles.Files + FontFiles.Count - 1;
+}
+
+static bool AtlasUsesFontData(const ImFontAtlas* atlas, const unsigned char* data)
+{
+    if (atlas == nullptr)
+        return false;
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    const ImVector_ImFontConfig* configs = &atlas->Sources;
+#else
+    const ImVector_ImFontConfig* configs = &atlas->ConfigData;
+#endif
+    for (int i = 0; i < configs->Size; ++i)
+    {
+        if (configs->Data[i].FontData == data)
+            return true;
+    }
+    return false;
+}
+
+// looks through the atlases of every context: the active one, the ones cached for other display scales and the builds
+static bool IsFontFileInUse(const FontFile* file)
+{
+    if (AtlasUsesFontData(SharedFonts.Atlas, file->Data))
+        return true;
+
+    for (const rlImGuiContext* context = &DefaultContext; context != nullptr; context = context->NextContext)
+    {
+        if (context->ImGui != nullptr && AtlasUsesFontData(context->ImGui->IO.Fonts, file->Data))
+            return true;
+        if (AtlasUsesFontData(context->FontBuild.Atlas, file->Data) || AtlasUsesFontData(context->FontBuild.Retired, file->Data))
+            return true;
+
+        for (int i = 0; i < context->ScaledFonts.Count; ++i)
+        {
+            if (AtlasUsesFontData(context->ScaledFonts.Atlases[i].Atlas, file->Data))
+                return true;
+        }
+    }
+    return false;
+}
+
+// unmaps the files no atlas uses anymore, returns false when some are still in use and were kept
+static bool UnloadFontFiles(void)
+{
+    int kept = 0;
+    for (int i = 0; i < FontFiles.Count; ++i)
+    {
+        FontFile* file = FontFiles.Files + i;
+        if (IsFontFileInUse(file))
+        {
+            FontFiles.Files[kept++] = *file;
+            continue;
+        }
+
+        UnmapFontFile(file);
+        MemFree(file->Path);
+    }
+    FontFiles.Count = kept;
+
+    if (kept > 0)
+        return false;
+
+    MemFree(FontFiles.Files);
+    FontFiles = (FontFileRegistry){ 0 };
+    return true;
+}
+
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+// the version of the compiled ImGui in the IMGUI_VERSION_NUM format, "1.91.9" is 19190
+static int GetImGuiVersionNum(void)
+{
+    int major = 0, minor = 0, patch = 0;
+    sscanf(igGetVersion(), "%d.%d.%d", &major, &minor, &patch);
+    return major * 10000 + minor * 100 + patch * 10;
+}
+#endif
+
+// adds a font whose data stays owned by the caller. 1.92 keeps the pointer it is given.
+// ImGui 1.91 and older copy font data the atlas doesn't own in AddFont, which would read the whole mapped file.
+// There is no API to avoid that, so the font is added as owned and the flag of the stored config is cleared again.
+// This depends on AddFont storing an owned config as is, which holds up to 1.91: the flip is only done for those
+// versions and when the stored config still points to the data. Otherwise the atlas keeps its copy.
+static ImFont* AddSharedFont(ImFontAtlas* atlas, const ImFontConfig* config)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    return ImFontAtlas_AddFont(atlas, config);
+#else
+    if (GetImGuiVersionNum() >= 19200)
+        return ImFontAtlas_AddFont(atlas, config);
+
+    ImFontConfig owned = *config;
+    owned.FontDataOwnedByAtlas = true;
+
+    int configCount = atlas->ConfigData.Size;
+    ImFont* font = ImFontAtlas_AddFont(atlas, &owned);
+    if (atlas->ConfigData.Size > configCount)
+    {
+        ImFontConfig* stored = atlas->ConfigData.Data + atlas->ConfigData.Size - 1;
+        if (stored->FontData == config->FontData)
+            stored->FontDataOwnedByAtlas = false;
+    }
+
+    return font;
+#endif
+}
+
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+
+// a changed density invalidates the baked pixels, BuildFontAtlas only builds atlases without any
+static void SetRasterizerDensity(ImFontAtlas* atlas, float density)
+{
+    bool changed = false;
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        changed |= atlas->ConfigData.Data[i].RasterizerDensity != density;
+        atlas->ConfigData.Data[i].RasterizerDensity = density;
+    }
+
+    if (changed)
+        ImFontAtlas_ClearTexData(atlas);
+}
+
+static void RunFontBuildJob(FontBuildJob* job)
+{
+    if (job->Setup != nullptr)
+        job->Setup(job->Atlas, job->UserData);
+    if (job->Density > 0)
+        SetRasterizerDensity(job->Atlas, job->Density);
+
+    BuildFontAtlas(job->Atlas, job->GlyphProfile, job->CacheDirectory);
+    RLIMGUI_ATOMIC_STORE(&job->Done, 1);
+}
+
+#if defined(RLIMGUI_NO_THREADS)
+static bool StartFontBuildThread(FontBuildJob* job)
+{
+    return false;
+}
+#elif defined(_WIN32)
+static void __cdecl FontBuildThread(void* job)
+{
+    RunFontBuildJob((FontBuildJob*)job);
+}
+
+// _beginthread closes the thread handle on its own, so nothing has to be joined
+static bool StartFontBuildThread(FontBuildJob* job)
+{
+    return _beginthread(FontBuildThread, 0, job) != (uintptr_t)-1;
+}
+#else
+static void* FontBuildThread(void* job)
+{
+    RunFontBuildJob((FontBuildJob*)job);
+    return nullptr;
+}
+
+static bool StartFontBuildThread(FontBuildJob* job)
+{
+    pthread_t thread;
+    if (pthread_create(&thread, nullptr, FontBuildThread, job) != 0)
+        return false;
+
+    pthread_detach(thread);
+    return true;
+}
+#endif
+
+// the worker only reads the job, so the settings the application can change while it runs are copied into it here
+static void CopyFontBuildSettings(FontBuildJob* job)
+{
+    MemFree(job->GlyphProfile);
+    job->GlyphProfile = nullptr;
+    if (GlyphProfile.Loaded != nullptr)
+    {
+        job->GlyphProfile = (unsigned char*)MemAlloc(RLIMGUI_GLYPH_PROFILE_BYTES);
+        memcpy(job->GlyphProfile, GlyphProfile.Loaded, RLIMGUI_GLYPH_PROFILE_BYTES);
+    }
+
+    memcpy(job->CacheDirectory, FontCacheDirectory, sizeof(job->CacheDirectory));
+}
+
+static bool StartFontBuild(FontBuildJob* job, rlImGuiFontAtlasSetup setup, void* userData)
+{
+    if (job->Atlas != nullptr)
+        return false;
+
+    job->Atlas = ImFontAtlas_ImFontAtlas();
+    job->Setup = (setup != nullptr) ? setup : AddDefaultFonts;
+    job->UserData = (setup != nullptr) ? userData : (void*)GetFontAwesomeRanges();
+    job->Done = 0;
+    job->Density = (CurrentContext->ScaledFonts.Enabled && !CurrentContext->SharedAtlas) ? CurrentContext->ScaledFonts.Scale : 0;
+    job->ScaleOnly = false;
+    CopyFontBuildSettings(job);
+
+    // without threads the atlas is built right away, it is still swapped in at the next frame
+    if (!StartFontBuildThread(job))
+        RunFontBuildJob(job);
+
+    return true;
+}
+
+static void FreeFontAtlas(ImFontAtlas* atlas)
+{
+    UnloadFontTexture(atlas);
+    ImFontAtlas_destroy(atlas);
+}
+
+// points the configs and custom glyphs of an atlas at the font object now holding their font
+static void RemapAtlasFont(ImFontAtlas* atlas, ImFont* from, ImFont* to)
+{
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+    {
+        if (atlas->ConfigData.Data[i].DstFont == from)
+            atlas->ConfigData.Data[i].DstFont = to;
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; ++i)
+    {
+        if (atlas->CustomRects.Data[i].Font == from)
+            atlas->CustomRects.Data[i].Font = to;
+    }
+}
+
+// exchanges what two atlases hold, so every ImGui context keeps its io.Fonts pointer (including contexts sharing the atlas).
+// Fonts at the same position swap their contents too, so ImFont pointers held by ImGui and the application stay valid
+static void SwapFontAtlasContents(ImFontAtlas* a, ImFontAtlas* b)
+{
+    ImFontAtlas contents = *a;
+    *a = *b;
+    *b = contents;
+
+    // the lock belongs to the context using the atlas object, not to the fonts
+    bool locked = a->Locked;
+    a->Locked = b->Locked;
+    b->Locked = locked;
+
+    int count = (a->Fonts.Size < b->Fonts.Size) ? a->Fonts.Size : b->Fonts.Size;
+    for (int i = 0; i < count; ++i)
+    {
+        // the font objects go back to the atlas they came from, with the contents of the other one
+        ImFont* aFont = b->Fonts.Data[i];
+        ImFont* bFont = a->Fonts.Data[i];
+
+        ImFont font = *aFont;
+        *aFont = *bFont;
+        *bFont = font;
+
+        a->Fonts.Data[i] = aFont;
+        b->Fonts.Data[i] = bFont;
+        RemapAtlasFont(a, bFont, aFont);
+        RemapAtlasFont(b, aFont, bFont);
+    }
+
+    for (int i = 0; i < a->Fonts.Size; ++i)
+        a->Fonts.Data[i]->ContainerAtlas = a;
+    for (int i = 0; i < b->Fonts.Size; ++i)
+        b->Fonts.Data[i]->ContainerAtlas = b;
+}
+
+// a copy of the fonts in an atlas, with its own copy of the font data
+static ImFontAtlas* CloneFontAtlas(const ImFontAtlas* source, float density)
+{
+    ImFontAtlas* atlas = ImFontAtlas_ImFontAtlas();
+    atlas->Flags = source->Flags;
+    atlas->TexDesiredWidth = source->TexDesiredWidth;
+    atlas->TexGlyphPadding = source->TexGlyphPadding;
+    atlas->FontBuilderIO = source->FontBuilderIO;
+    atlas->FontBuilderFlags = source->FontBuilderFlags;
+
+    // configs are added in order, so merged fonts end up in the same font as in the source
+    for (int i = 0; i < source->ConfigData.Size; ++i)
+    {
+        ImFontConfig config = source->ConfigData.Data[i];
+        config.DstFont = nullptr;
+        config.RasterizerDensity = density;
+
+        // data the atlas doesn't own comes from rlImGuiAddFontFile, the mapped file is shared instead of copied
+        if (!config.FontDataOwnedByAtlas)
+        {
+            AddSharedFont(atlas, &config);
+            continue;
+        }
+
+        void* data = igMemAlloc(config.FontDataSize);
+        memcpy(data, config.FontData, config.FontDataSize);
+        config.FontData = data;
+        ImFontAtlas_AddFont(atlas, &config);
+    }
+
+    return atlas;
+}
+
+static size_t GetFontAtlasBytes(const ImFontAtlas* atlas)
+{
+    size_t texels = (size_t)atlas->TexWidth * atlas->TexHeight;
+    const Texture2D* texture = (const Texture2D*)atlas->TexID;
+
+    size_t bytes = 0;
+    if (texture != nullptr)
+        bytes += texels * ((texture->format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE) ? 1 : 4);
+    if (atlas->TexPixelsAlpha8 != nullptr)
+        bytes += texels;
+    if (atlas->TexPixelsRGBA32 != nullptr)
+        bytes += texels * 4;
+
+    // mapped font files are shared by every atlas
+    for (int i = 0; i < atlas->ConfigData.Size; ++i)
+        bytes += atlas->ConfigData.Data[i].FontDataOwnedByAtlas ? atlas->ConfigData.Data[i].FontDataSize : 0;
+
+    return bytes;
+}
+
+// the display scale atlases are keyed by, rounded so scales that only differ by float noise share an atlas
+static float GetFontAtlasScale(void)
+{
+    return roundf(GetDisplayScale().x * 100) / 100;
+}
+
+static int FindScaledFontAtlas(const ScaledFontAtlasCache* cache, float scale)
+{
+    for (int i = 0; i < cache->Count; ++i)
+    {
+        if (cache->Atlases[i].Scale == scale)
+            return i;
+    }
+    return -1;
+}
+
+static void RemoveScaledFontAtlas(ScaledFontAtlasCache* cache, int index)
+{
+    FreeFontAtlas(cache->Atlases[index].Atlas);
+    cache->Atlases[index] = cache->Atlases[--cache->Count];
+}
+
+static void ClearScaledFontAtlases(ScaledFontAtlasCache* cache)
+{
+    while (cache->Count > 0)
+        RemoveScaledFontAtlas(cache, cache->Count - 1);
+}
+
+static int FindOldestScaledFontAtlas(const ScaledFontAtlasCache* cache)
+{
+    int oldest = 0;
+    for (int i = 1; i < cache->Count; ++i)
+    {
+        if (cache->Atlases[i].LastUsed < cache->Atlases[oldest].LastUsed)
+            oldest = i;
+    }
+    return oldest;
+}
+
+// keeps an inactive atlas, freeing the least recently used ones over the entry or memory limit
+// the stored atlas is never evicted here, even when it alone is over the memory budget: it can be the atlas
+// that was just swapped out, and a pending frame may still draw with its texture
+static void StoreScaledFontAtlas(ScaledFontAtlasCache* cache, float scale, ImFontAtlas* atlas)
+{
+    size_t bytes = GetFontAtlasBytes(atlas);
+
+    while (cache->Count > 0)
+    {
+        size_t total = bytes;
+        for (int i = 0; i < cache->Count; ++i)
+            total += cache->Atlases[i].Bytes;
+
+        if (cache->Count < RLIMGUI_MAX_SCALED_FONT_ATLASES && total <= RLIMGUI_SCALED_FONT_ATLAS_MEMORY)
+            break;
+
+        RemoveScaledFontAtlas(cache, FindOldestScaledFontAtlas(cache));
+    }
+
+    cache->Atlases[cache->Count++] = (ScaledFontAtlas){ scale, atlas, bytes, GetTime() };
+}
+
+// moves the fonts of another atlas into io.Fonts, the other atlas gets the fonts that were active
+static void ActivateFontAtlas(ImFontAtlas* atlas)
+{
+    // fonts keep their objects, unless the new atlas has fewer fonts than the default font's position
+    ImGuiIO* io = igGetIO();
+    int defaultFont = FindFontIndex(io->Fonts, io->FontDefault);
+    SwapFontAtlasContents(io->Fonts, atlas);
+    io->FontDefault = (defaultFont >= 0 && defaultFont < io->Fonts->Fonts.Size) ? io->Fonts->Fonts.Data[defaultFont] : nullptr;
+
+    CurrentContext->FrameCache.Valid = false;
+}
+
+static void StartScaledFontBuild(FontBuildJob* job, float scale)
+{
+    job->Atlas = CloneFontAtlas(igGetIO()->Fonts, scale);
+    job->Setup = nullptr;
+    job->UserData = nullptr;
+    job->Done = 0;
+    job->Density = scale;
+    job->ScaleOnly = true;
+    CopyFontBuildSettings(job);
+
+    if (!StartFontBuildThread(job))
+        RunFontBuildJob(job);
+}
+
+// switches to the atlas for the current display scale, from the cache or from a new build
+static void UpdateFontAtlasScale(FontBuildJob* job)
+{
+    ScaledFontAtlasCache* cache = &CurrentContext->ScaledFonts;
+    if (!cache->Enabled || CurrentContext->SharedAtlas || job->Atlas != nullptr || igGetIO()->Fonts->Fonts.Size == 0)
+        return;
+
+    float scale = GetFontAtlasScale();
+    if (scale == cache->Scale)
+        return;
+
+    int index = FindScaledFontAtlas(cache, scale);
+    if (index < 0)
+    {
+        StartScaledFontBuild(job, scale);
+        return;
+    }
+
+    // the atlas object stays in the cache slot, with the fonts of the scale that was active
+    ScaledFontAtlas* entry = &cache->Atlases[index];
+    ActivateFontAtlas(entry->Atlas);
+    entry->Scale = cache->Scale;
+    entry->Bytes = GetFontAtlasBytes(entry->Atlas);
+    entry->LastUsed = GetTime();
+    cache->Scale = scale;
+}
+
+// called before the active fonts are rebuilt on the main thread. They may have changed,
+// so the atlases for other scales are dropped and built again when they are needed
+static void ResetScaledFontAtlases(void)
+{
+    ScaledFontAtlasCache* cache = &CurrentContext->ScaledFonts;
+    if (!cache->Enabled || CurrentContext->SharedAtlas)
+        return;
+
+    ClearScaledFontAtlases(cache);
+    SetRasterizerDensity(igGetIO()->Fonts, cache->Scale);
+}
+
+// called at a frame boundary on the GL thread, before ImGui starts a new frame
+static void ApplyFontBuild(FontBuildJob* job)
+{
+    if (job->Retired != nullptr)
+    {
+        FreeFontAtlas(job->Retired);
+        job->Retired = nullptr;
+    }
+
+    if (job->Atlas != nullptr && RLIMGUI_ATOMIC_LOAD(&job->Done))
+    {
+        ImFontAtlas* built = job->Atlas;
+        job->Atlas = nullptr;
+        MemFree(job->GlyphProfile);
+        job->GlyphProfile = nullptr;
+
+        Texture2D* fontTexture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+        *fontTexture = LoadFontTexture(built);
+        built->TexID = (ImTextureID)fontTexture;
+
+        ScaledFontAtlasCache* cache = &CurrentContext->ScaledFonts;
+        if (!job->ScaleOnly)
+        {
+            // new fonts, the atlases for other scales have the old ones
+            ActivateFontAtlas(built);
+            ClearScaledFontAtlases(cache);
+            job->Setup = nullptr;
+            job->Retired = built;
+        }
+        else if (!cache->Enabled)
+        {
+            job->Retired = built;
+        }
+        else if (job->Density != GetFontAtlasScale())
+        {
+            // the window moved on while the atlas was built
+            StoreScaledFontAtlas(cache, job->Density, built);
+        }
+        else
+        {
+            ActivateFontAtlas(built);
+            StoreScaledFontAtlas(cache, cache->Scale, built);
+            cache->Scale = job->Density;
+        }
+    }
+
+    UpdateFontAtlasScale(job);
+}
+
+// waits for a running build, then frees everything the job still holds
+static void CancelFontBuild(FontBuildJob* job)
+{
+    if (job->Atlas != nullptr)
+    {
+        while (!RLIMGUI_ATOMIC_LOAD(&job->Done))
+            WaitTime(0.001);
+
+        ImFontAtlas_destroy(job->Atlas);
+    }
+
+    if (job->Retired != nullptr)
+        FreeFontAtlas(job->Retired);
+
+    MemFree(job->GlyphProfile);
+    *job = (FontBuildJob){ 0 };
+}
+
+#else
+
+// glyphs are rasterized when they are first drawn, so the build has nothing heavy left for a thread.
+// The setup still runs at the next frame boundary, where the old fonts can be dropped
+static bool StartFontBuild(FontBuildJob* job, rlImGuiFontAtlasSetup setup, void* userData)
+{
+    if (job->Setup != nullptr)
+        return false;
+
+    job->Setup = (setup != nullptr) ? setup : AddDefaultFonts;
+    job->UserData = (setup != nullptr) ? userData : (void*)GetFontAwesomeRanges();
+    return true;
+}
+
+static void ApplyFontBuild(FontBuildJob* job)
+{
+    if (job->Setup == nullptr)
+        return;
+
+    ImGuiIO* io = igGetIO();
+    int defaultFont = FindFontIndex(io->Fonts, io->FontDefault);
+
+    ImFontAtlas_ClearFonts(io->Fonts);
+    job->Setup(io->Fonts, job->UserData);
+    io->FontDefault = (defaultFont >= 0 && defaultFont < io->Fonts->Fonts.Size) ? io->Fonts->Fonts.Data[defaultFont] : nullptr;
+
+    job->Setup = nullptr;
+    CurrentContext->FrameCache.Valid = false;
+}
+
+static void CancelFontBuild(FontBuildJob* job)
+{
+    *job = (FontBuildJob){ 0 };
+}
+
+// ImGui bakes glyphs for each rasterizer density on its own, there are no atlases per display scale to keep
+static void ResetScaledFontAtlases(void)
+{
+}
+
+#endif
+
+static const char* GetClipTextCallback(ImGuiContext* context)
+{
+    return GetClipboardText();
+}
+
+static void SetClipTextCallback(ImGuiContext* context, const char* text)
+{
+    SetClipboardText(text);
+}
+
+static void ImGuiNewFrame(const WindowState* window, float deltaTime)
+{
+    ImGuiIO* io = igGetIO();
+
+    Vector2 resolutionScale = window->Scale;
+    io->DisplaySize = window->Size;
+
+    // contexts that draw to their own area are not affected by the window size
+    if (CurrentContext->DisplaySize.x > 0 && CurrentContext->DisplaySize.y > 0)
+        io->DisplaySize = CurrentContext->DisplaySize;
+    else if (CurrentContext->RenderTarget != nullptr)
+        io->DisplaySize = (ImVec2){ (float)CurrentContext->RenderTarget->texture.width, (float)CurrentContext->RenderTarget->texture.height };
+
+    io->DisplayFramebufferScale = (ImVec2){resolutionScale.x, resolutionScale.y};
+
+    if (deltaTime <= 0)
+        deltaTime = 0.001f;
+
+    io->DeltaTime = deltaTime;
+
+    if (CurrentContext->ReceivesInput && (igGetIO()->BackendFlags & ImGuiBackendFlags_HasMouseCursors))
+    {
+        if ((io->ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange) == 0)
+        {
+            ImGuiMouseCursor imgui_cursor = igGetMouseCursor();
+            if (imgui_cursor != CurrentContext->CurrentMouseCursor || io->MouseDrawCursor)
+            {
+                CurrentContext->CurrentMouseCursor = imgui_cursor;
+                if (io->MouseDrawCursor || imgui_cursor == ImGuiMouseCursor_None)
+                {
+                    HideCursor();
+                }
+                else
+                {
+                    ShowCursor();
+
+                    if (!(io->ConfigFlags & ImGuiConfigFlags_NoMouseCursorChange))
+                    {
+                        SetMouseCursor((imgui_cursor > -1 && imgui_cursor < ImGuiMouseCursor_COUNT) ? MouseCursorMap[imgui_cursor] : MOUSE_CURSOR_DEFAULT);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void InvalidateRenderState(void)
+{
+    RenderState.ScissorEnabled = -1;
+    RenderState.TextureId = -1;
+    RenderState.ShaderId = -1;
+    RenderState.BlendMode = -1;
+    RenderState.CullingEnabled = -1;
+}
+
+// GL state is applied right away while the rlgl batch is drawn later, so pending geometry has to go out first.
+// A flush resets the batch texture to the default one.
+static void FlushRenderBatch(void)
+{
+    rlDrawRenderBatchActive();
+    RenderState.TextureId = -1;
+}
+
+static bool CountStateChange(bool needed)
+{
+    if (needed)
+        CurrentContext->FrameStats.StateChangesApplied++;
+    else
+        CurrentContext->FrameStats.StateChangesSkipped++;
+
+    return needed;
+}
+
+static void SetScissorState(int x, int y, int width, int height)
+{
+    if (!CountStateChange(RenderState.ScissorEnabled != 1 || RenderState.ScissorX != x || RenderState.ScissorY != y || RenderState.ScissorWidth != width || RenderState.ScissorHeight != height))
+        return;
+
+    FlushRenderBatch();
+    if (RenderState.ScissorEnabled != 1)
+        rlEnableScissorTest();
+    rlScissor(x, y, width, height);
+
+    RenderState.ScissorEnabled = 1;
+    RenderState.ScissorX = x;
+    RenderState.ScissorY = y;
+    RenderState.ScissorWidth = width;
+    RenderState.ScissorHeight = height;
+}
+
+static void DisableScissorState(void)
+{
+    if (!CountStateChange(RenderState.ScissorEnabled != 0))
+        return;
+
+    FlushRenderBatch();
+    rlDisableScissorTest();
+    RenderState.ScissorEnabled = 0;
+}
+
+// shader for the rlgl batch, which is drawn with whatever shader is set when it is flushed
+static void SetBatchShaderState(Shader shader)
+{
+    if (!CountStateChange(RenderState.ShaderId != (int)shader.id))
+        return;
+
+    FlushRenderBatch();
+    rlSetShader(shader.id, shader.locs);
+    RenderState.ShaderId = (int)shader.id;
+}
+
+// texture for the rlgl batch, used by the immediate path
+static void SetBatchTextureState(unsigned int textureId)
+{
+    if (!CountStateChange(RenderState.TextureId != (int)textureId))
+        return;
+
+    rlSetTexture(textureId);
+    RenderState.TextureId = (int)textureId;
+}
+
+// enables a shader for the GPU buffer paths, with the uniforms the rlgl batch would set
+static void UseBufferShader(Shader shader)
+{
+    static const float white[4] = { 1, 1, 1, 1 };
+    static const int textureSlot = 0;
+
+    rlEnableShader(shader.id);
+
+    // same transform the rlgl batch would use, including any rlPushMatrix transform
+    Matrix mvp = MatrixMultiply(MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview()), rlGetMatrixProjection());
+    rlSetUniformMatrix(shader.locs[RL_SHADER_LOC_MATRIX_MVP], mvp);
+    rlSetUniform(shader.locs[RL_SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+    rlSetUniform(shader.locs[RL_SHADER_LOC_MAP_DIFFUSE], &textureSlot, RL_SHADER_UNIFORM_INT, 1);
+
+    RenderState.ShaderId = (int)shader.id;
+}
+
+// texture bound directly to the shader, used by the GPU buffer paths.
+// rlgl binds the same attribute locations for every shader, so switching shaders keeps the vertex layout valid
+static void SetShaderTextureState(unsigned int textureId)
+{
+    if (!CountStateChange(RenderState.TextureId != (int)textureId))
+        return;
+
+    Shader shader = GetTextureShader(textureId);
+    if (RenderState.ShaderId != (int)shader.id)
+        UseBufferShader(shader);
+
+    rlEnableTexture(textureId);
+    RenderState.TextureId = (int)textureId;
+}
+
+// Passes drawn straight into the application's target keep the blend mode the application set. rlgl can't report it,
+// so once an offscreen pass changed the mode the frame ends with raylib's default alpha blending, like EndBlendMode.
+// Global like RenderState, the flag tracks the GL context and is reset at the end of every render.
+#define RLIMGUI_BLEND_TARGET -1
+static bool BlendModeChanged = false;
+
+static void SetBlendModeState(int mode)
+{
+    if (!CountStateChange(RenderState.BlendMode != mode))
+        return;
+
+    FlushRenderBatch();
+    BlendModeChanged = true;
+
+    // the only custom mode the backend uses is for offscreen layers: colors blend as usual (and end up premultiplied)
+    // while alpha accumulates coverage, so the layer can later be composited with premultiplied alpha blending
+    if (mode == RL_BLEND_CUSTOM_SEPARATE)
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD, RL_FUNC_ADD);
+
+    rlSetBlendMode(mode);
+    RenderState.BlendMode = mode;
+}
+
+static void SetCullingState(bool enabled)
+{
+    if (!CountStateChange(RenderState.CullingEnabled != (int)enabled))
+        return;
+
+    FlushRenderBatch();
+    if (enabled)
+        rlEnableBackfaceCulling();
+    else
+        rlDisableBackfaceCulling();
+    RenderState.CullingEnabled = (int)enabled;
+}
+
+static void ImGuiTriangleVert(const ImDrawVert* idx_vert)
+{
+    Color* c;
+    c = (Color*)&idx_vert->col;
+    rlColor4ub(c->r, c->g, c->b, c->a);
+    rlTexCoord2f(idx_vert->uv.x, idx_vert->uv.y);
+    rlVertex2f(idx_vert->pos.x, idx_vert->pos.y);
+}
+
+static void ImGuiRenderTriangles(unsigned int count, int indexStart, const ImDrawIdx* indexBuffer, const ImDrawVert* vertBuffer, void* texturePtr)
+{
+    if (count < 3)
+        return;
+
+    Texture* texture = (Texture*)texturePtr;
+
+    unsigned int textureId = (texture == nullptr) ? 0 : texture->id;
+
+    // shader and texture go before rlBegin, like raylib does. Changing the shader flushes the batch and a new texture
+    // opens a new draw entry, either resets the draw mode set by rlBegin
+    if (RenderState.TextureId != (int)textureId)
+        SetBatchShaderState(GetTextureShader(textureId));
+
+    SetBatchTextureState(textureId);
+    rlBegin(RL_TRIANGLES);
+
+    for (unsigned int i = 0; i <= (count - 3); i += 3)
+    {
+        const ImDrawIdx indexA = indexBuffer[indexStart + i];
+        const ImDrawIdx indexB = indexBuffer[indexStart + i + 1];
+        const ImDrawIdx indexC = indexBuffer[indexStart + i + 2];
+
+        const ImDrawVert* vertexA = vertBuffer + indexA;
+        const ImDrawVert* vertexB = vertBuffer + indexB;
+        const ImDrawVert* vertexC = vertBuffer + indexC;
+
+        ImGuiTriangleVert(vertexA);
+        ImGuiTriangleVert(vertexB);
+        ImGuiTriangleVert(vertexC);
+    }
+    rlEnd();
+}
+
+static int GrowCapacity(int current, int required)
+{
+    int grown = current + current / 2;
+    return (grown > required) ? grown : required;
+}
+
+static bool ReserveRetainedBuffers(int vtxCount, int idxCount)
+{
+    if (Retained.VaoId == 0)
+    {
+        // returns 0 when vertex arrays are not supported (OpenGL 1.1, ES2 without the extension)
+        Retained.VaoId = rlLoadVertexArray();
+        if (Retained.VaoId == 0)
+            return false;
+    }
+
+    if (vtxCount <= Retained.VtxCapacity && idxCount <= Retained.IdxCapacity)
+        return true;
+
+    rlEnableVertexArray(Retained.VaoId);
+
+    if (vtxCount > Retained.VtxCapacity)
+    {
+        if (Retained.VboId != 0)
+            rlUnloadVertexBuffer(Retained.VboId);
+
+        Retained.VtxCapacity = GrowCapacity(Retained.VtxCapacity, vtxCount);
+        Retained.VboId = rlLoadVertexBuffer(nullptr, Retained.VtxCapacity * (int)sizeof(ImDrawVert), true);
+    }
+
+    if (idxCount > Retained.IdxCapacity)
+    {
+        if (Retained.IboId != 0)
+            rlUnloadVertexBuffer(Retained.IboId);
+
+        // the element buffer binding is stored in the vertex array
+        Retained.IdxCapacity = GrowCapacity(Retained.IdxCapacity, idxCount);
+        Retained.IboId = rlLoadVertexBufferElement(nullptr, Retained.IdxCapacity * (int)sizeof(ImDrawIdx), true);
+    }
+
+    rlDisableVertexArray();
+    return true;
+}
+
+static void UnloadRetainedBuffers(void)
+{
+    if (Retained.VboId != 0)
+        rlUnloadVertexBuffer(Retained.VboId);
+    if (Retained.IboId != 0)
+        rlUnloadVertexBuffer(Retained.IboId);
+    if (Retained.VaoId != 0)
+        rlUnloadVertexArray(Retained.VaoId);
+
+    Retained = (RetainedBuffers){ 0 };
+}
+
+// points the shader attributes at the ImDrawVert layout, starting at the given vertex in the shared vertex buffer
+static void SetRetainedVertexLayout(const int* shaderLocs, int baseVertex)
+{
+    int offset = baseVertex * (int)sizeof(ImDrawVert);
+
+    rlEnableVertexBuffer(Retained.VboId);
+
+    rlSetVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_POSITION], 2, RL_FLOAT, false, sizeof(ImDrawVert), offset + (int)offsetof(ImDrawVert, pos));
+    rlEnableVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_POSITION]);
+
+    rlSetVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], 2, RL_FLOAT, false, sizeof(ImDrawVert), offset + (int)offsetof(ImDrawVert, uv));
+    rlEnableVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01]);
+
+    rlSetVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_COLOR], 4, RL_UNSIGNED_BYTE, true, sizeof(ImDrawVert), offset + (int)offsetof(ImDrawVert, col));
+    rlEnableVertexAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_COLOR]);
+}
+
+static void BeginBufferShader(void)
+{
+    UseBufferShader(GetDefaultShader());
+    rlActiveTextureSlot(0);
+}
+
+static void EndBufferShader(void)
+{
+    rlDisableVertexArray();
+    rlDisableTexture();
+    rlDisableShader();
+    RenderState.TextureId = -1;
+    RenderState.ShaderId = -1;
+}
+
+static void RetainedDrawCommand(const ImDrawCmd* cmd, int baseIndex)
+{
+    if (cmd->ElemCount < 3)
+        return;
+
+    Texture* texture = GetCommandTexture(cmd);
+    SetShaderTextureState((texture == nullptr) ? rlGetTextureIdDefault() : texture->id);
+
+    // the element buffer is bound, so the pointer argument is used as an index offset
+    rlDrawVertexArrayElements(baseIndex + (int)cmd->IdxOffset, (int)cmd->ElemCount, nullptr);
+}
+
+static rlRenderBatch* ReserveDedicatedBatch(int vertexCount)
+{
+    int maxElements = RLIMGUI_MAX_BATCH_ELEMENTS;
+    switch (rlGetVersion())
+    {
+    case RL_OPENGL_11:
+        return nullptr;     // no render batch support, the default batch is used as is
+    case RL_OPENGL_ES_20:
+        maxElements = 16384;    // the batch uses 16 bit indices on ES2
+        break;
+    default:
+        break;
+    }
+
+    int requiredElements = (vertexCount + 3) / 4;
+    if (requiredElements > maxElements)
+        requiredElements = maxElements;     // rlgl splits anything bigger with its own flushes
+
+    if (DedicatedBatch.Elements == 0 || requiredElements > DedicatedBatch.Elements)
+    {
+        int elements = GrowCapacity(DedicatedBatch.Elements, requiredElements);
+        if (elements < RLIMGUI_MIN_BATCH_ELEMENTS)
+            elements = RLIMGUI_MIN_BATCH_ELEMENTS;
+        if (elements > maxElements)
+            elements = maxElements;
+
+        if (DedicatedBatch.Elements != 0)
+            rlUnloadRenderBatch(DedicatedBatch.Batch);
+
+        DedicatedBatch.Batch = rlLoadRenderBatch(1, elements);
+        DedicatedBatch.Elements = elements;
+    }
+
+    return &DedicatedBatch.Batch;
+}
+
+static void UnloadDedicatedBatch(void)
+{
+    if (DedicatedBatch.Elements != 0)
+        rlUnloadRenderBatch(DedicatedBatch.Batch);
+
+    DedicatedBatch = (ImGuiRenderBatch){ 0 };
+}
+
+// Kernels that gather indexed ImDrawVerts into the position, texcoord and color streams.
+// ImDrawVert is pos, uv, col, so pos and uv are always one unaligned 16 byte load.
+static void DeinterleaveScalar(const ImDrawVert* vertices, const ImDrawIdx* indices, int count, float* positions, float* texcoords, unsigned int* colors)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        const ImDrawVert* vert = vertices + indices[i];
+        positions[i * 2] = vert->pos.x;
+        positions[i * 2 + 1] = vert->pos.y;
+        texcoords[i * 2] = vert->uv.x;
+        texcoords[i * 2 + 1] = vert->uv.y;
+        colors[i] = vert->col;
+    }
+}
+
+#if defined(RLIMGUI_SSE2)
+static void DeinterleaveSSE2(const ImDrawVert* vertices, const ImDrawIdx* indices, int count, float* positions, float* texcoords, unsigned int* colors)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        const ImDrawVert* a = vertices + indices[i];
+        const ImDrawVert* b = vertices + indices[i + 1];
+        const ImDrawVert* c = vertices + indices[i + 2];
+        const ImDrawVert* d = vertices + indices[i + 3];
+
+        __m128 va = _mm_loadu_ps(&a->pos.x);
+        __m128 vb = _mm_loadu_ps(&b->pos.x);
+        __m128 vc = _mm_loadu_ps(&c->pos.x);
+        __m128 vd = _mm_loadu_ps(&d->pos.x);
+
+        _mm_storeu_ps(positions + i * 2, _mm_movelh_ps(va, vb));
+        _mm_storeu_ps(positions + i * 2 + 4, _mm_movelh_ps(vc, vd));
+        _mm_storeu_ps(texcoords + i * 2, _mm_movehl_ps(vb, va));
+        _mm_storeu_ps(texcoords + i * 2 + 4, _mm_movehl_ps(vd, vc));
+        _mm_storeu_si128((__m128i*)(colors + i), _mm_set_epi32((int)d->col, (int)c->col, (int)b->col, (int)a->col));
+    }
+
+    DeinterleaveScalar(vertices, indices + i, count - i, positions + i * 2, texcoords + i * 2, colors + i);
+}
+#endif
+
+#if defined(RLIMGUI_X86)
+RLIMGUI_TARGET_AVX2 static __m128i LoadVertexByteOffsets(const ImDrawIdx* indices)
+{
+    __m128i idx;
+    if (sizeof(ImDrawIdx) == 2)
+        idx = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i*)indices));
+    else
+        idx = _mm_loadu_si128((const __m128i*)indices);
+
+    return _mm_mullo_epi32(idx, _mm_set1_epi32((int)sizeof(ImDrawVert)));
+}
+
+RLIMGUI_TARGET_AVX2 static void DeinterleaveAVX2(const ImDrawVert* vertices, const ImDrawIdx* indices, int count, float* positions, float* texcoords, unsigned int* colors)
+{
+    // each pos and uv pair is gathered as one 64 bit lane
+    const double* posBase = (const double*)&vertices->pos;
+    const double* uvBase = (const double*)&vertices->uv;
+    const int* colBase = (const int*)&vertices->col;
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i offsetsLo = LoadVertexByteOffsets(indices + i);
+        __m128i offsetsHi = LoadVertexByteOffsets(indices + i + 4);
+
+        _mm256_storeu_pd((double*)(positions + i * 2), _mm256_i32gather_pd(posBase, offsetsLo, 1));
+        _mm256_storeu_pd((double*)(positions + i * 2 + 8), _mm256_i32gather_pd(posBase, offsetsHi, 1));
+        _mm256_storeu_pd((double*)(texcoords + i * 2), _mm256_i32gather_pd(uvBase, offsetsLo, 1));
+        _mm256_storeu_pd((double*)(texcoords + i * 2 + 8), _mm256_i32gather_pd(uvBase, offsetsHi, 1));
+        _mm256_storeu_si256((__m256i*)(colors + i), _mm256_i32gather_epi32(colBase, _mm256_inserti128_si256(_mm256_castsi128_si256(offsetsLo), offsetsHi, 1), 1));
+    }
+
+    DeinterleaveScalar(vertices, indices + i, count - i, positions + i * 2, texcoords + i * 2, colors + i);
+}
+
+// MSVC and clang-cl have no __builtin_cpu_supports, or need compiler-rt for it, so they ask cpuid directly
+static bool CPUSupportsAVX2(void)
+{
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0);
+    if (regs[0] < 7)
+        return false;
+
+    // the OS has to save the AVX registers too
+    __cpuid(regs, 1);
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+#if defined(RLIMGUI_NEON)
+static void DeinterleaveNEON(const ImDrawVert* vertices, const ImDrawIdx* indices, int count, float* positions, float* texcoords, unsigned int* colors)
+{
+    int i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        const ImDrawVert* a = vertices + indices[i];
+        const ImDrawVert* b = vertices + indices[i + 1];
+
+        float32x4_t va = vld1q_f32(&a->pos.x);
+        float32x4_t vb = vld1q_f32(&b->pos.x);
+
+        vst1q_f32(positions + i * 2, vcombine_f32(vget_low_f32(va), vget_low_f32(vb)));
+        vst1q_f32(texcoords + i * 2, vcombine_f32(vget_high_f32(va), vget_high_f32(vb)));
+        colors[i] = a->col;
+        colors[i + 1] = b->col;
+    }
+
+    DeinterleaveScalar(vertices, indices + i, count - i, positions + i * 2, texcoords + i * 2, colors + i);
+}
+#endif
+
+static void SelectStreamKernel(void)
+{
+    if (StreamKernel != nullptr)
+        return;
+
+    StreamKernel = DeinterleaveScalar;
+    StreamKernelName = "scalar";
+
+#if defined(RLIMGUI_SSE2)
+    StreamKernel = DeinterleaveSSE2;
+    StreamKernelName = "SSE2";
+#endif
+#if defined(RLIMGUI_X86)
+    if (CPUSupportsAVX2())
+    {
+        StreamKernel = DeinterleaveAVX2;
+        StreamKernelName = "AVX2";
+    }
+#endif
+#if defined(RLIMGUI_NEON)
+    StreamKernel = DeinterleaveNEON;
+    StreamKernelName = "NEON";
+#endif
+}
+
+static void SetStreamAttribute(int location, unsigned int vboId, int components, int type, bool normalized)
+{
+    rlEnableVertexBuffer(vboId);
+    rlSetVertexAttribute(location, components, type, normalized, 0, 0);
+    rlEnableVertexAttribute(location);
+}
+
+static bool ReserveVertexStreams(int vertexCount)
+{
+    if (Streams.VaoId == 0)
+    {
+        Streams.VaoId = rlLoadVertexArray();
+        if (Streams.VaoId == 0)
+            return false;
+    }
+
+    if (vertexCount <= Streams.Capacity)
+        return true;
+
+    int capacity = GrowCapacity(Streams.Capacity, vertexCount);
+
+    Streams.Positions = (float*)MemRealloc(Streams.Positions, capacity * 2 * sizeof(float));
+    Streams.TexCoords = (float*)MemRealloc(Streams.TexCoords, capacity * 2 * sizeof(float));
+    Streams.Colors = (unsigned int*)MemRealloc(Streams.Colors, capacity * sizeof(unsigned int));
+
+    rlEnableVertexArray(Streams.VaoId);
+    if (Streams.Capacity != 0)
+    {
+        rlUnloadVertexBuffer(Streams.PositionVboId);
+        rlUnloadVertexBuffer(Streams.TexCoordVboId);
+        rlUnloadVertexBuffer(Streams.ColorVboId);
+    }
+
+    Streams.PositionVboId = rlLoadVertexBuffer(nullptr, capacity * 2 * sizeof(float), true);
+    Streams.TexCoordVboId = rlLoadVertexBuffer(nullptr, capacity * 2 * sizeof(float), true);
+    Streams.ColorVboId = rlLoadVertexBuffer(nullptr, capacity * sizeof(unsigned int), true);
+
+    // the streams are tightly packed, so the layout only changes when the buffers are recreated
+    const int* shaderLocs = rlGetShaderLocsDefault();
+    SetStreamAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_POSITION], Streams.PositionVboId, 2, RL_FLOAT, false);
+    SetStreamAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_TEXCOORD01], Streams.TexCoordVboId, 2, RL_FLOAT, false);
+    SetStreamAttribute(shaderLocs[RL_SHADER_LOC_VERTEX_COLOR], Streams.ColorVboId, 4, RL_UNSIGNED_BYTE, true);
+    rlDisableVertexArray();
+
+    Streams.Capacity = capacity;
+    return true;
+}
+
+static void UnloadVertexStreams(void)
+{
+    if (Streams.Capacity != 0)
+    {
+        rlUnloadVertexBuffer(Streams.PositionVboId);
+        rlUnloadVertexBuffer(Streams.TexCoordVboId);
+        rlUnloadVertexBuffer(Streams.ColorVboId);
+    }
+    if (Streams.VaoId != 0)
+        rlUnloadVertexArray(Streams.VaoId);
+
+    MemFree(Streams.Positions);
+    MemFree(Streams.TexCoords);
+    MemFree(Streams.Colors);
+    Streams = (VertexStreams){ 0 };
+
+    MemFree(StreamDraws);
+    StreamDraws = nullptr;
+    StreamDrawCapacity = 0;
+}
+
+static void EnableScissor(float x, float y, float width, float height)
+{
+    ImVec2 scale = CurrentContext->FrameTarget.FramebufferScale;
+
+    SetScissorState((int)(x * scale.x),
+        (int)((CurrentContext->FrameTarget.DisplaySize.y - (int)(y + height)) * scale.y),
+        (int)(width * scale.x),
+        (int)(height * scale.y));
+}
+
+// only reads the draw data, so a context can be rendered while another thread builds its next frame
+static void SetupFrameTarget(const ImDrawData* draw_data)
+{
+    CurrentContext->FrameTarget.DisplayPos = draw_data->DisplayPos;
+    CurrentContext->FrameTarget.DisplaySize = draw_data->DisplaySize;
+    CurrentContext->FrameTarget.FramebufferScale = draw_data->FramebufferScale;
+
+    // a render texture is its own framebuffer, ImGui units map to texture pixels and the scissor is flipped by the texture height
+    if (ActiveRenderTarget != nullptr)
+    {
+        CurrentContext->FrameTarget.DisplaySize = (ImVec2){ (float)ActiveRenderTarget->texture.width, (float)ActiveRenderTarget->texture.height };
+        CurrentContext->FrameTarget.FramebufferScale = (ImVec2){ 1, 1 };
+        return;
+    }
+
+#if !defined(__APPLE__)
+    if (!IsWindowState(FLAG_WINDOW_HIGHDPI))
+    {
+        CurrentContext->FrameTarget.FramebufferScale.x = 1;
+        CurrentContext->FrameTarget.FramebufferScale.y = 1;
+    }
+#endif
+}
+
+// commands with an empty clip rect, or one that is entirely outside the display, can't produce any pixels
+static bool IsCommandVisible(const ImDrawCmd* cmd)
+{
+    if (cmd->ElemCount == 0)
+        return false;
+
+    float minX = fmaxf(cmd->ClipRect.x - CurrentContext->FrameTarget.DisplayPos.x, 0);
+    float minY = fmaxf(cmd->ClipRect.y - CurrentContext->FrameTarget.DisplayPos.y, 0);
+    float maxX = fminf(cmd->ClipRect.z - CurrentContext->FrameTarget.DisplayPos.x, CurrentContext->FrameTarget.DisplaySize.x);
+    float maxY = fminf(cmd->ClipRect.w - CurrentContext->FrameTarget.DisplayPos.y, CurrentContext->FrameTarget.DisplaySize.y);
+
+    return maxX > minX && maxY > minY;
+}
+
+static void SetupMouseCursors(void)
+{
+    MouseCursorMap[ImGuiMouseCursor_Arrow] = MOUSE_CURSOR_ARROW;
+    MouseCursorMap[ImGuiMouseCursor_TextInput] = MOUSE_CURSOR_IBEAM;
+    MouseCursorMap[ImGuiMouseCursor_Hand] = MOUSE_CURSOR_POINTING_HAND;
+    MouseCursorMap[ImGuiMouseCursor_ResizeAll] = MOUSE_CURSOR_RESIZE_ALL;
+    MouseCursorMap[ImGuiMouseCursor_ResizeEW] = MOUSE_CURSOR_RESIZE_EW;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNESW] = MOUSE_CURSOR_RESIZE_NESW;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNS] = MOUSE_CURSOR_RESIZE_NS;
+    MouseCursorMap[ImGuiMouseCursor_ResizeNWSE] = MOUSE_CURSOR_RESIZE_NWSE;
+    MouseCursorMap[ImGuiMouseCursor_NotAllowed] = MOUSE_CURSOR_NOT_ALLOWED;
+}
+
+void SetupFontAwesome(void)
+{
+    AddFontAwesome(igGetIO()->Fonts, GetFontAwesomeRanges());
+}
+
+// number of contexts with an initialized backend. The GPU buffers, shaders and upload memory are shared by all of them
+// and freed when the last one shuts down
+static int BackendRefCount = 0;
+
+void SetupBackend(void)
+{
+    if (!CurrentContext->BackendReady)
+    {
+        CurrentContext->BackendReady = true;
+        BackendRefCount++;
+    }
+
+    ImGuiIO* io = igGetIO();
+    io->BackendPlatformName = "imgui_impl_raylib";
+    io->BackendFlags |= ImGuiBackendFlags_HasGamepad | ImGuiBackendFlags_HasSetMousePos;
+
+    // every render path honors ImDrawCmd::VtxOffset, so ImGui doesn't need to split large draw lists at 64K vertices
+    io->BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+#ifndef PLATFORM_DRM
+    io->BackendFlags |= ImGuiBackendFlags_HasMouseCursors;
+#endif
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    // font textures are created and updated from the requests in ImDrawData::Textures, see UpdateTextures
+    io->BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+#ifndef RLIMGUI_FONT_TEXTURE_RGBA
+    if (LoadAlphaShader())
+        io->Fonts->TexDesiredFormat = ImTextureFormat_Alpha8;
+#endif
+#endif
+
+    io->MousePos = (ImVec2){0, 0};
+
+    ImGuiPlatformIO* platformIO = igGetPlatformIO();
+
+    platformIO->Platform_SetClipboardTextFn = SetClipTextCallback;
+    platformIO->Platform_GetClipboardTextFn = GetClipTextCallback;
+    platformIO->Platform_ClipboardUserData = nullptr;
+}
+
+// a shared atlas is filled and uploaded by the first context that uses it
+static bool IsFontAtlasReady(const ImFontAtlas* atlas)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    // the atlas has no texture before the first frame is rendered
+    return CurrentContext->SharedAtlas && SharedFonts.RefCount > 1;
+#else
+    return atlas->TexID != 0;
+#endif
+}
+
+void rlImGuiEndInitImGui(void)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    bool fontsReady = IsFontAtlasReady(igGetIO()->Fonts);
+
+    if (!fontsReady)
+        SetupFontAwesome();
+
+    SetupMouseCursors();
+
+    SetupBackend();
+
+    if (!fontsReady)
+        ReloadFonts();
+}
+
+static void SetupGlobals(void)
+{
+    CurrentContext->LastFrameFocused = IsWindowFocused();
+    CurrentContext->LastControlPressed = false;
+    CurrentContext->LastShiftPressed = false;
+    CurrentContext->LastAltPressed = false;
+    CurrentContext->LastSuperPressed = false;
+    CurrentContext->LastMousePos = (ImVec2){ -FLT_MAX, -FLT_MAX };
+}
+
+void rlImGuiBeginInitImGui(void)
+{
+    SetupGlobals();
+    if (CurrentContext->ImGui == nullptr)
+    {
+        ImFontAtlas* atlas = nullptr;
+        if (SharedFonts.Enabled)
+        {
+            if (SharedFonts.Atlas == nullptr)
+                SharedFonts.Atlas = ImFontAtlas_ImFontAtlas();
+
+            atlas = SharedFonts.Atlas;
+            SharedFonts.RefCount++;
+            CurrentContext->SharedAtlas = true;
+        }
+
+        CurrentContext->ImGui = igCreateContext(atlas);
+    }
+
+    // ImGui only makes a new context current when there is none
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    CurrentContext->ContextFrames = (ContextFrameQueue){ .Write = 0, .Read = 1, .Latest = 2 };
+    CurrentContext->Window = SampleWindowState();
+
+    ImGuiIO* io = igGetIO();
+
+    if (!IsFontAtlasReady(io->Fonts))
+        ImFontAtlas_AddFontDefault(io->Fonts, nullptr);
+}
+
+void rlImGuiSetup(bool dark)
+{
+    rlImGuiBeginInitImGui();
+
+    ImGuiStyle* style = igGetStyle();
+
+    if (dark)
+        igStyleColorsDark(style);
+    else
+        igStyleColorsLight(style);
+
+    rlImGuiEndInitImGui();
+}
+
+void rlImGuiSetContext(ImGuiContext *imgui_context)
+{
+    CurrentContext->ImGui = imgui_context;
+}
+
+ImGuiContext* rlImGuiGetContext()
+{
+    return CurrentContext->ImGui;
+}
+
+void rlImGuiReloadFonts(void)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    ResetScaledFontAtlases();
+    ReloadFonts();
+}
+
+bool rlImGuiReloadFontsAsync(rlImGuiFontAtlasSetup setup, void* userData)
+{
+    // the swap and the retired atlas belong to one context, other contexts could still draw with the old fonts and texture
+    if (CurrentContext->SharedAtlas && SharedFonts.RefCount > 1)
+        return false;
+
+    return StartFontBuild(&CurrentContext->FontBuild, setup, userData);
+}
+
+bool rlImGuiIsFontBuildPending(void)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    return CurrentContext->FontBuild.Setup != nullptr;
+#else
+    // also builds for a new display scale, those have no setup
+    FontBuildJob* job = &CurrentContext->FontBuild;
+    return job->Atlas != nullptr && !RLIMGUI_ATOMIC_LOAD(&job->Done);
+#endif
+}
+
+void rlImGuiSetRenderMode(rlImGuiRenderMode mode)
+{
+    CurrentContext->RenderMode = mode;
+}
+
+rlImGuiRenderMode rlImGuiGetRenderMode(void)
+{
+    return CurrentContext->RenderMode;
+}
+
+rlImGuiRenderStats rlImGuiGetRenderStats(void)
+{
+    return CurrentContext->FrameStats;
+}
+
+void rlImGuiSetFrameCaching(bool enabled)
+{
+    CurrentContext->FrameCache.Enabled = enabled;
+    CurrentContext->FrameCache.Valid = false;
+    CurrentContext->FrameCache.Hits = 0;
+    CurrentContext->FrameCache.Misses = 0;
+}
+
+void rlImGuiInvalidateFrameCache(void)
+{
+    CurrentContext->FrameCache.Valid = false;
+    InvalidateWindowLayers(&CurrentContext->WindowLayers);
+}
+
+void rlImGuiSetWindowLayers(bool enabled)
+{
+    CurrentContext->WindowLayers.Enabled = enabled;
+    if (!enabled)
+        UnloadWindowLayers(&CurrentContext->WindowLayers);
+}
+
+void rlImGuiSetResolutionScale(float scale)
+{
+    if (scale >= 1)
+        scale = 1;
+    else if (scale < RLIMGUI_MIN_RESOLUTION_SCALE)
+        scale = RLIMGUI_MIN_RESOLUTION_SCALE;
+
+    CurrentContext->Resolution.Scale = scale;
+}
+
+float rlImGuiGetResolutionScale(void)
+{
+    return GetResolutionScale(CurrentContext);
+}
+
+void rlImGuiSetResolutionSharpening(float amount)
+{
+    CurrentContext->Resolution.Sharpness = (amount > 0) ? amount : 0;
+}
+
+float rlImGuiGetFrameCacheHitRate(void)
+{
+    unsigned int total = CurrentContext->FrameCache.Hits + CurrentContext->FrameCache.Misses;
+    return (total == 0) ? 0.0f : (float)CurrentContext->FrameCache.Hits / (float)total;
+}
+
+const char* rlImGuiGetStreamKernelName(void)
+{
+    SelectStreamKernel();
+    return StreamKernelName;
+}
+
+void rlImGuiBegin(void)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+    rlImGuiBeginDelta(GetFrameTime());
+}
+
+// starts the ImGui frame of the current context without any GL calls. Input that was already sent to ImGui
+// for this frame is not read again
+static void BeginFrame(const WindowState* window, float deltaTime, bool eventsProcessed)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    CurrentContext->Idle.FrameSkipped = false;
+    CurrentContext->Idle.LastFrameTime = GetTime();
+    CurrentContext->FrameBuildStart = CurrentContext->Idle.LastFrameTime;
+
+    ImGuiNewFrame(window, deltaTime);
+    if (CurrentContext->ReceivesInput && !eventsProcessed)
+        ImGui_ImplRaylib_ProcessEvents();
+    igNewFrame();
+}
+
+// the GL side of starting a frame on the main thread: the delayed frame is drawn and finished fonts are swapped in
+static void PrepareFrame(void)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+    rlImGuiRenderPendingFrame();
+    ApplyFontBuild(&CurrentContext->FontBuild);
+}
+
+void rlImGuiBeginDelta(float deltaTime)
+{
+    PrepareFrame();
+
+    WindowState window = SampleWindowState();
+    BeginFrame(&window, deltaTime, false);
+}
+
+static void* ReserveArena(void* data, int* capacity, int required, size_t elementSize)
+{
+    if (required <= *capacity)
+        return data;
+
+    *capacity = GrowCapacity(*capacity, required);
+    return MemRealloc(data, *capacity * elementSize);
+}
+
+static void CaptureDrawData(DrawDataSnapshot* snapshot, const ImDrawData* draw_data)
+{
+    int listCount = draw_data->CmdListsCount;
+    int commandCount = 0;
+    int nameBytes = 0;
+    for (int l = 0; l < listCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+        commandCount += commandList->CmdBuffer.Size;
+        if (commandList->_OwnerName != nullptr)
+            nameBytes += (int)strlen(commandList->_OwnerName) + 1;
+    }
+
+    int listCapacity = snapshot->ListCapacity;
+    snapshot->Lists = (ImDrawList*)ReserveArena(snapshot->Lists, &snapshot->ListCapacity, listCount, sizeof(ImDrawList));
+    if (snapshot->ListCapacity != listCapacity)
+        snapshot->ListPointers = (ImDrawList**)MemRealloc(snapshot->ListPointers, snapshot->ListCapacity * sizeof(ImDrawList*));
+    snapshot->Commands = (ImDrawCmd*)ReserveArena(snapshot->Commands, &snapshot->CommandCapacity, commandCount, sizeof(ImDrawCmd));
+    snapshot->Vertices = (ImDrawVert*)ReserveArena(snapshot->Vertices, &snapshot->VertexCapacity, draw_data->TotalVtxCount, sizeof(ImDrawVert));
+    snapshot->Indices = (ImDrawIdx*)ReserveArena(snapshot->Indices, &snapshot->IndexCapacity, draw_data->TotalIdxCount, sizeof(ImDrawIdx));
+    snapshot->Names = (char*)ReserveArena(snapshot->Names, &snapshot->NameCapacity, nameBytes, 1);
+
+    ImDrawCmd* commands = snapshot->Commands;
+    ImDrawVert* vertices = snapshot->Vertices;
+    ImDrawIdx* indices = snapshot->Indices;
+    char* names = snapshot->Names;
+
+    for (int l = 0; l < listCount; ++l)
+    {
+        const ImDrawList* source = draw_data->CmdLists.Data[l];
+        ImDrawList* list = snapshot->Lists + l;
+
+        // the header keeps the flags and owner, the buffers point into the arenas
+        *list = *source;
+        list->CmdBuffer = (ImVector_ImDrawCmd){ source->CmdBuffer.Size, source->CmdBuffer.Size, commands };
+        list->VtxBuffer = (ImVector_ImDrawVert){ source->VtxBuffer.Size, source->VtxBuffer.Size, vertices };
+        list->IdxBuffer = (ImVector_ImDrawIdx){ source->IdxBuffer.Size, source->IdxBuffer.Size, indices };
+
+        memcpy(commands, source->CmdBuffer.Data, source->CmdBuffer.Size * sizeof(ImDrawCmd));
+        memcpy(vertices, source->VtxBuffer.Data, source->VtxBuffer.Size * sizeof(ImDrawVert));
+        memcpy(indices, source->IdxBuffer.Data, source->IdxBuffer.Size * sizeof(ImDrawIdx));
+        commands += source->CmdBuffer.Size;
+        vertices += source->VtxBuffer.Size;
+        indices += source->IdxBuffer.Size;
+
+        // the window can be destroyed while the snapshot is still drawn
+        if (source->_OwnerName != nullptr)
+        {
+            size_t length = strlen(source->_OwnerName) + 1;
+            memcpy(names, source->_OwnerName, length);
+            list->_OwnerName = names;
+            names += length;
+        }
+
+        snapshot->ListPointers[l] = list;
+    }
+
+    snapshot->DrawData = *draw_data;
+    snapshot->DrawData.CmdLists = (ImVector_ImDrawListPtr){ listCount, listCount, snapshot->ListPointers };
+    snapshot->Valid = true;
+}
+
+static void UnloadDrawDataSnapshot(DrawDataSnapshot* snapshot)
+{
+    MemFree(snapshot->Lists);
+    MemFree(snapshot->ListPointers);
+    MemFree(snapshot->Commands);
+    MemFree(snapshot->Vertices);
+    MemFree(snapshot->Indices);
+    MemFree(snapshot->Names);
+    *snapshot = (DrawDataSnapshot){ 0 };
+}
+
+// ImGui only needs a new frame after input, while it is still reacting to it (active items, text cursors, tooltips),
+// when the application asked for one or when there is no frame to draw again.
+// With an update interval the UI ticks at that rate instead, and right away on activity
+static bool UINeedsRedraw(bool hadEvents, double now)
+{
+    ImGuiIO* io = igGetIO();
+
+    bool active = hadEvents || CurrentContext->Idle.RedrawRequested || IsWindowResized() || CurrentContext->Idle.LastFrameTime == 0;
+    active = active || igIsAnyItemActive() || igIsAnyMouseDown() || io->WantTextInput;
+
+    // a finished font build is only swapped in by a new frame
+    FontBuildJob* job = &CurrentContext->FontBuild;
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    active = active || job->Setup != nullptr;
+#else
+    active = active || (job->Atlas != nullptr && RLIMGUI_ATOMIC_LOAD(&job->Done));
+#endif
+
+    if (active)
+        CurrentContext->Idle.LastActivityTime = now;
+
+    CurrentContext->Idle.RedrawRequested = false;
+
+    if (active || igGetDrawData() == nullptr)
+        return true;
+
+    if (CurrentContext->UpdateInterval > 0)
+        return now - CurrentContext->Idle.LastFrameTime >= CurrentContext->UpdateInterval;
+
+    return now - CurrentContext->Idle.LastActivityTime < RLIMGUI_IDLE_GRACE_TIME;
+}
+
+static void SetEventWaiting(bool wait)
+{
+    if (wait == EventWaitingActive)
+        return;
+
+    if (wait)
+        EnableEventWaiting();
+    else
+        DisableEventWaiting();
+
+    EventWaitingActive = wait;
+}
+
+bool rlImGuiBeginIfNeeded(void)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    // the input decides if there is a frame, so it is read first. ImGui only queues it, the frame
+    // started below is the first thing that uses it
+    double now = GetTime();
+    bool hadEvents = CurrentContext->ReceivesInput && ImGui_ImplRaylib_ProcessEvents();
+    bool needed = UINeedsRedraw(hadEvents, now);
+
+    SetEventWaiting(IdleEventWaiting && !needed);
+
+    CurrentContext->Idle.FrameSkipped = !needed;
+    if (!needed)
+        return false;
+
+    // skipped frames are not lost time for ImGui, the delta covers everything since its last frame
+    float deltaTime = (CurrentContext->Idle.LastFrameTime == 0) ? GetFrameTime() : (float)(now - CurrentContext->Idle.LastFrameTime);
+
+    PrepareFrame();
+
+    WindowState window = SampleWindowState();
+    BeginFrame(&window, deltaTime, true);
+    return true;
+}
+
+void rlImGuiRequestRedraw(void)
+{
+    CurrentContext->Idle.RedrawRequested = true;
+}
+
+void rlImGuiSetUpdateInterval(float seconds)
+{
+    CurrentContext->UpdateInterval = (seconds > 0) ? seconds : 0;
+}
+
+void rlImGuiSetIdleEventWaiting(bool enabled)
+{
+    IdleEventWaiting = enabled;
+    if (!enabled)
+        SetEventWaiting(false);
+}
+
+// ends the ImGui frame of the current context, returns the draw data to render now or NULL if there is nothing to render yet
+static ImDrawData* EndFrame(bool allowLatency)
+{
+    igSetCurrentContext(CurrentContext->ImGui);
+
+    if (CurrentContext->Idle.FrameSkipped)
+    {
+        CurrentContext->Idle.FrameSkipped = false;
+        CurrentContext->FramePending = false;
+
+        // the live draw data of the last frame stays valid until the next ImGui frame starts,
+        // the snapshot is used when the application may be touching ImGui in between
+        if (CurrentContext->Snapshot.Valid)
+            return &CurrentContext->Snapshot.DrawData;
+
+        return igGetDrawData();
+    }
+
+    igRender();
+
+    ImDrawData* drawData = igGetDrawData();
+    bool delayed = allowLatency && CurrentContext->FrameLatency > 0;
+    if (CurrentContext->UpdateInterval > 0 || delayed)
+    {
+        CaptureDrawData(&CurrentContext->Snapshot, drawData);
+        drawData = &CurrentContext->Snapshot.DrawData;
+    }
+    else
+    {
+        CurrentContext->Snapshot.Valid = false;
+    }
+
+    CurrentContext->FrameBuildMilliseconds = (float)((GetTime() - CurrentContext->FrameBuildStart) * 1000.0);
+
+    // the snapshot is drawn at the start of the next frame, or by an explicit rlImGuiRenderPendingFrame
+    if (delayed)
+    {
+        CurrentContext->FramePending = true;
+        return nullptr;
+    }
+
+    return drawData;
+}
+
+// draws into a render texture with the texture as the display: no window size and no HighDPI scale.
+// The layer blend mode is used so the alpha in the texture is coverage, and the colors end up premultiplied
+static void RenderDrawDataToTexture(ImDrawData* draw_data, const RenderTexture* target, bool clear)
+{
+    BeginRenderTarget(*target);
+    if (clear)
+        ClearBackground(BLANK);
+
+    ActiveRenderTarget = target;
+    ImGui_ImplRaylib_RenderDrawData(draw_data);
+    ActiveRenderTarget = nullptr;
+
+    EndOffscreenTarget();
+}
+
+void rlImGuiEnd(void)
+{
+    ImDrawData* drawData = EndFrame(true);
+    if (drawData != nullptr)
+        ImGui_ImplRaylib_RenderDrawData(drawData);
+}
+
+void rlImGuiEndToTexture(const RenderTexture* target, bool clear)
+{
+    ImDrawData* drawData = EndFrame(false);
+    if (drawData != nullptr && target != nullptr && target->id != 0)
+        RenderDrawDataToTexture(drawData, target, clear);
+}
+
+void rlImGuiRenderPendingFrame(void)
+{
+    if (!CurrentContext->FramePending)
+        return;
+
+    CurrentContext->FramePending = false;
+    igSetCurrentContext(CurrentContext->ImGui);
+    ImGui_ImplRaylib_RenderDrawData(&CurrentContext->Snapshot.DrawData);
+}
+
+void rlImGuiSetFrameLatency(int frames)
+{
+    CurrentContext->FrameLatency = (frames > 0) ? 1 : 0;
+}
+
+rlImGuiContext* rlImGuiCreateContext(bool darkTheme)
+{
+    rlImGuiContext* previous = CurrentContext;
+    ImGuiContext* previousImGui = igGetCurrentContext();
+
+    // MemAlloc clears the memory
+    rlImGuiContext* context = (rlImGuiContext*)MemAlloc(sizeof(rlImGuiContext));
+    context->ReceivesInput = true;
+    context->CurrentMouseCursor = ImGuiMouseCursor_COUNT;
+    context->NextContext = DefaultContext.NextContext;
+    DefaultContext.NextContext = context;
+
+    CurrentContext = context;
+    rlImGuiSetup(darkTheme);
+
+    CurrentContext = previous;
+    igSetCurrentContext(previousImGui);
+    return context;
+}
+
+void rlImGuiDestroyContext(rlImGuiContext* context)
+{
+    if (context == nullptr || context == &DefaultContext)
+        return;
+
+    rlImGuiContext* previous = CurrentContext;
+    CurrentContext = context;
+    rlImGuiShutdown();
+
+    CurrentContext = (previous == context) ? &DefaultContext : previous;
+    if (CurrentContext->ImGui != nullptr)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    for (rlImGuiContext* listed = &DefaultContext; listed != nullptr; listed = listed->NextContext)
+    {
+        if (listed->NextContext == context)
+        {
+            listed->NextContext = context->NextContext;
+            break;
+        }
+    }
+
+    MemFree(context);
+}
+
+void rlImGuiSetCurrentContext(rlImGuiContext* context)
+{
+    CurrentContext = (context != nullptr) ? context : &DefaultContext;
+    if (CurrentContext->ImGui != nullptr)
+        igSetCurrentContext(CurrentContext->ImGui);
+}
+
+rlImGuiContext* rlImGuiGetCurrentContext(void)
+{
+    return CurrentContext;
+}
+
+void rlImGuiSetContextInput(rlImGuiContext* context, bool receivesInput)
+{
+    if (context == nullptr)
+        context = CurrentContext;
+
+    // start from a clean edge state, so keys held while input was off are seen as new presses
+    context->ReceivesInput = receivesInput;
+    context->LastMousePos = (ImVec2){ -FLT_MAX, -FLT_MAX };
+}
+
+void rlImGuiSetContextDisplaySize(rlImGuiContext* context, float width, float height)
+{
+    if (context == nullptr)
+        context = CurrentContext;
+
+    context->DisplaySize = (ImVec2){ width, height };
+}
+
+void rlImGuiSetContextRenderTarget(rlImGuiContext* context, const RenderTexture* target)
+{
+    if (context == nullptr)
+        context = CurrentContext;
+
+    context->RenderTarget = target;
+}
+
+void rlImGuiBeginContext(rlImGuiContext* context)
+{
+    rlImGuiSetCurrentContext(context);
+    BeginFrame(&context->Window, context->Window.DeltaTime, false);
+}
+
+// the lock is only held to hand a frame over, both sides do their copying and GL work outside of it
+static void LockContextFrames(ContextFrameQueue* frames)
+{
+    while (RLIMGUI_ATOMIC_EXCHANGE(&frames->Lock, 1) != 0)
+        ;
+}
+
+static void UnlockContextFrames(ContextFrameQueue* frames)
+{
+    RLIMGUI_ATOMIC_STORE(&frames->Lock, 0);
+}
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+static TextureRequest* AddTextureRequest(TextureRequestList* list, ImTextureStatus status, Texture2D* texture)
+{
+    list->Data = (TextureRequest*)ReserveArena(list->Data, &list->Capacity, list->Count + 1, sizeof(TextureRequest));
+    TextureRequest* request = list->Data + list->Count++;
+    *request = (TextureRequest){ status, texture };
+    return request;
+}
+
+static void AppendTextureRequests(TextureRequestList* list, const TextureRequestList* requests)
+{
+    list->Data = (TextureRequest*)ReserveArena(list->Data, &list->Capacity, list->Count + requests->Count, sizeof(TextureRequest));
+    memcpy(list->Data + list->Count, requests->Data, requests->Count * sizeof(TextureRequest));
+    list->Count += requests->Count;
+}
+
+static void CopyTextureRequestPixels(TextureRequest* request, ImTextureData* tex, int x, int y, int width, int height)
+{
+    request->Format = tex->Format;
+    request->X = x;
+    request->Y = y;
+    request->Width = width;
+    request->Height = height;
+    request->Pixels = (unsigned char*)MemAlloc(width * height * tex->BytesPerPixel);
+
+    for (int row = 0; row < height; ++row)
+        memcpy(request->Pixels + row * width * tex->BytesPerPixel, ImTextureData_GetPixelsAt(tex, x, y + row), width * tex->BytesPerPixel);
+}
+
+// answers the texture requests of a frame built by rlImGuiEndContext, like UpdateTextures but without GL calls
+static void QueueTextureRequests(TextureRequestList* list, const ImDrawData* draw_data)
+{
+    if (draw_data->Textures == nullptr)
+        return;
+
+    for (int i = 0; i < draw_data->Textures->Size; ++i)
+    {
+        ImTextureData* tex = draw_data->Textures->Data[i];
+
+        if (tex->Status == ImTextureStatus_WantCreate)
+        {
+            Texture2D* texture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+            CopyTextureRequestPixels(AddTextureRequest(list, ImTextureStatus_WantCreate, texture), tex, 0, 0, tex->Width, tex->Height);
+            ImTextureData_SetTexID(tex, (ImTextureID)(uintptr_t)texture);
+            ImTextureData_SetStatus(tex, ImTextureStatus_OK);
+        }
+        else if (tex->Status == ImTextureStatus_WantUpdates)
+        {
+            Texture2D* texture = (Texture2D*)(uintptr_t)tex->TexID;
+            for (int r = 0; r < tex->Updates.Size; ++r)
+            {
+                const ImTextureRect* rect = &tex->Updates.Data[r];
+                CopyTextureRequestPixels(AddTextureRequest(list, ImTextureStatus_WantUpdates, texture), tex, rect->x, rect->y, rect->w, rect->h);
+            }
+            ImTextureData_SetStatus(tex, ImTextureStatus_OK);
+        }
+        // frames drawn after the handover don't use the texture, the ones before it are never drawn again
+        else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+        {
+            AddTextureRequest(list, ImTextureStatus_WantDestroy, (Texture2D*)(uintptr_t)tex->TexID);
+            ImTextureData_SetTexID(tex, 0);
+            ImTextureData_SetStatus(tex, ImTextureStatus_Destroyed);
+        }
+    }
+}
+
+// the snapshot resolves its texture ids now, so drawing it never reads the ImTextureData the builder keeps changing
+static void DetachTextureRefs(DrawDataSnapshot* snapshot)
+{
+    ImDrawData* draw_data = &snapshot->DrawData;
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        ImDrawList* commandList = draw_data->CmdLists.Data[l];
+        for (int c = 0; c < commandList->CmdBuffer.Size; ++c)
+        {
+            ImTextureRef* ref = &commandList->CmdBuffer.Data[c].TexRef;
+            if (ref->_TexData != nullptr)
+            {
+                ref->_TexID = ref->_TexData->TexID;
+                ref->_TexData = nullptr;
+            }
+        }
+    }
+
+    draw_data->Textures = nullptr;
+}
+
+// runs on the thread that owns the GL context, before the frame the requests belong to is drawn
+static void ApplyTextureRequests(TextureRequestList* list)
+{
+    for (int i = 0; i < list->Count; ++i)
+    {
+        TextureRequest* request = list->Data + i;
+        int bytesPerPixel = (request->Format == ImTextureFormat_Alpha8) ? 1 : 4;
+        if (request->Status == ImTextureStatus_WantCreate)
+            LoadTextureData(request->Texture, request->Pixels, request->Width, request->Height, request->Format);
+        else if (request->Status == ImTextureStatus_WantUpdates)
+            UploadTextureRect(request->Texture, request->Pixels, request->Width * bytesPerPixel, bytesPerPixel, request->X, request->Y, request->Width, request->Height);
+        else if (request->Texture != nullptr)
+            UnloadTextureData(request->Texture);
+
+        MemFree(request->Pixels);
+    }
+
+    // the cached frame was drawn with the old texture contents
+    if (list->Count > 0)
+        CurrentContext->FrameCache.Valid = false;
+    list->Count = 0;
+}
+#endif
+
+void rlImGuiEndContext(rlImGuiContext* context)
+{
+    rlImGuiSetCurrentContext(context);
+    igRender();
+
+    // no GL calls here, the copy is drawn by rlImGuiRenderContext on the thread that owns the GL context
+    ContextFrameQueue* frames = &CurrentContext->ContextFrames;
+    DrawDataSnapshot* snapshot = frames->Snapshots + frames->Write;
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    TextureRequestList requests = { 0 };
+    QueueTextureRequests(&requests, igGetDrawData());
+    CaptureDrawData(snapshot, igGetDrawData());
+    DetachTextureRefs(snapshot);
+#else
+    CaptureDrawData(snapshot, igGetDrawData());
+#endif
+
+    // the requests are handed over with the frame, the render thread applies them right before drawing it
+    LockContextFrames(frames);
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    AppendTextureRequests(&frames->Requests, &requests);
+#endif
+    frames->Write = (int)(RLIMGUI_ATOMIC_EXCHANGE(&frames->Latest, frames->Write | RLIMGUI_SNAPSHOT_FRESH) & 3);
+    UnlockContextFrames(frames);
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    MemFree(requests.Data);
+#endif
+
+    CurrentContext->FramePending = false;
+    CurrentContext->FrameBuildMilliseconds = (float)((GetTime() - CurrentContext->FrameBuildStart) * 1000.0);
+}
+
+void rlImGuiRenderContext(rlImGuiContext* context)
+{
+    if (context == nullptr)
+        context = CurrentContext;
+
+    // the latest finished frame, or the last one drawn again
+    ContextFrameQueue* frames = &context->ContextFrames;
+    if (RLIMGUI_ATOMIC_LOAD(&frames->Latest) & RLIMGUI_SNAPSHOT_FRESH)
+    {
+        LockContextFrames(frames);
+        frames->Read = (int)(RLIMGUI_ATOMIC_EXCHANGE(&frames->Latest, frames->Read) & 3);
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+        TextureRequestList requests = frames->Applying;
+        frames->Applying = frames->Requests;
+        frames->Requests = requests;
+#endif
+        UnlockContextFrames(frames);
+    }
+
+    rlImGuiContext* previous = CurrentContext;
+    CurrentContext = context;
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    ApplyTextureRequests(&frames->Applying);
+#endif
+
+    const DrawDataSnapshot* snapshot = frames->Snapshots + frames->Read;
+    if (snapshot->Valid && context->RenderTarget != nullptr)
+        RenderDrawDataToTexture((ImDrawData*)&snapshot->DrawData, context->RenderTarget, false);
+    else if (snapshot->Valid)
+        ImGui_ImplRaylib_RenderDrawData((ImDrawData*)&snapshot->DrawData);
+
+    // this runs on the main thread, the next rlImGuiBeginContext may not
+    context->Window = SampleWindowState();
+
+    CurrentContext = previous;
+}
+
+void rlImGuiShutdown(void)
+{
+    if (CurrentContext->ImGui == nullptr)
+        return;
+
+    igSetCurrentContext(CurrentContext->ImGui);
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    // textures of frames that were never drawn are created first, so ImGui_ImplRaylib_Shutdown destroys them like any other
+    ContextFrameQueue* frames = &CurrentContext->ContextFrames;
+    LockContextFrames(frames);
+    AppendTextureRequests(&frames->Applying, &frames->Requests);
+    frames->Requests.Count = 0;
+    UnlockContextFrames(frames);
+    ApplyTextureRequests(&frames->Applying);
+    MemFree(frames->Requests.Data);
+    MemFree(frames->Applying.Data);
+#endif
+
+    ImGui_ImplRaylib_Shutdown();
+    SetEventWaiting(false);
+    CurrentContext->Idle = (IdleFrameState){ 0 };
+    CurrentContext->FramePending = false;
+    UnloadDrawDataSnapshot(&CurrentContext->Snapshot);
+    for (int i = 0; i < 3; ++i)
+        UnloadDrawDataSnapshot(CurrentContext->ContextFrames.Snapshots + i);
+    CurrentContext->ContextFrames = (ContextFrameQueue){ .Write = 0, .Read = 1, .Latest = 2 };
+
+    igDestroyContext(CurrentContext->ImGui);
+    CurrentContext->ImGui = nullptr;
+
+    // ImGui never frees an atlas it was given
+    if (CurrentContext->SharedAtlas)
+    {
+        CurrentContext->SharedAtlas = false;
+        if (--SharedFonts.RefCount == 0)
+        {
+            ImFontAtlas_destroy(SharedFonts.Atlas);
+            SharedFonts.Atlas = nullptr;
+        }
+    }
+}
+
+void rlImGuiSetFontCacheDirectory(const char* path)
+{
+    if (path == nullptr)
+    {
+        FontCacheDirectory[0] = 0;
+        return;
+    }
+
+    strncpy(FontCacheDirectory, path, sizeof(FontCacheDirectory) - 1);
+    FontCacheDirectory[sizeof(FontCacheDirectory) - 1] = 0;
+}
+
+ImFont* rlImGuiAddFontFile(const char* fileName, float size, const ImFontConfig* config)
+{
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    const FontFile* file = GetFontFile(fileName);
+    if (file == nullptr)
+        return nullptr;
+
+    ImFontConfig* defaults = ImFontConfig_ImFontConfig();
+    ImFontConfig fontConfig = (config != nullptr) ? *config : *defaults;
+    ImFontConfig_destroy(defaults);
+
+    fontConfig.FontData = file->Data;
+    fontConfig.FontDataSize = file->Size;
+    fontConfig.FontDataOwnedByAtlas = false;
+    fontConfig.SizePixels = size;
+    if (fontConfig.Name[0] == 0)
+        snprintf(fontConfig.Name, sizeof(fontConfig.Name), "%s, %.0fpx", GetFileName(fileName), size);
+
+    return AddSharedFont(igGetIO()->Fonts, &fontConfig);
+}
+
+bool rlImGuiUnloadFontFiles(void)
+{
+    return UnloadFontFiles();
+}
+
+void rlImGuiSetFontAwesomeCodepoints(const int* codepoints, int count)
+{
+#ifndef NO_FONT_AWESOME
+    if (FontAwesomeRanges != nullptr)
+    {
+        RetiredFontAwesomeRanges = (ImWchar**)MemRealloc(RetiredFontAwesomeRanges, sizeof(ImWchar*) * (RetiredFontAwesomeRangeCount + 1));
+        RetiredFontAwesomeRanges[RetiredFontAwesomeRangeCount++] = FontAwesomeRanges;
+        FontAwesomeRanges = nullptr;
+    }
+
+    if (codepoints == nullptr)
+        return;
+
+    int* sorted = (int*)MemAlloc(sizeof(int) * (count + 1));
+    memcpy(sorted, codepoints, sizeof(int) * count);
+    qsort(sorted, count, sizeof(int), CompareCodepoints);
+
+    // neighbouring icons share one range, duplicates and codepoints outside the font are dropped
+    FontAwesomeRanges = (ImWchar*)MemAlloc(sizeof(ImWchar) * (count * 2 + 1));
+    int size = 0;
+    for (int i = 0; i < count; ++i)
+    {
+        int codepoint = sorted[i];
+        if (codepoint < ICON_MIN_FA || codepoint > ICON_MAX_FA)
+            continue;
+
+        if (size > 0 && codepoint <= FontAwesomeRanges[size - 1] + 1)
+        {
+            FontAwesomeRanges[size - 1] = (ImWchar)codepoint;
+            continue;
+        }
+
+        FontAwesomeRanges[size++] = (ImWchar)codepoint;
+        FontAwesomeRanges[size++] = (ImWchar)codepoint;
+    }
+    FontAwesomeRanges[size] = 0;
+
+    MemFree(sorted);
+#endif
+}
+
+void rlImGuiSetGlyphProfiling(bool enabled)
+{
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+    if (enabled && !GlyphProfile.Recording)
+    {
+        if (GlyphProfile.Used == nullptr)
+            GlyphProfile.Used = (unsigned char*)MemAlloc(RLIMGUI_GLYPH_PROFILE_BYTES);
+        else
+            memset(GlyphProfile.Used, 0, RLIMGUI_GLYPH_PROFILE_BYTES);
+
+        // text fields can be typed into with any key
+        AddRequiredCodepoints(GlyphProfile.Used);
+    }
+    GlyphProfile.Recording = enabled;
+#endif
+}
+
+bool rlImGuiSaveGlyphProfile(const char* fileName)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    return false;
+#else
+    if (GlyphProfile.Used == nullptr)
+        return false;
+
+    int count = GetCodepointRanges(GlyphProfile.Used, nullptr);
+    ImWchar* ranges = (ImWchar*)MemAlloc(sizeof(ImWchar) * (count * 2 + 1));
+    GetCodepointRanges(GlyphProfile.Used, ranges);
+
+    // one range per line, so the file can also be included as the initializer of an ImWchar array
+    int capacity = 128 + count * 32;
+    char* text = (char*)MemAlloc(capacity);
+    int length = snprintf(text, capacity, "// glyph ranges recorded by rlImGui, %d ranges\n", count);
+    for (int i = 0; i < count; ++i)
+        length += snprintf(text + length, capacity - length, "0x%04X, 0x%04X,\n", (unsigned int)ranges[i * 2], (unsigned int)ranges[i * 2 + 1]);
+    snprintf(text + length, capacity - length, "0\n");
+
+    bool saved = SaveFileText(fileName, text);
+    MemFree(text);
+    MemFree(ranges);
+    return saved;
+#endif
+}
+
+bool rlImGuiLoadGlyphProfile(const char* fileName)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    return fileName == nullptr;
+#else
+    MemFree(GlyphProfile.Loaded);
+    GlyphProfile.Loaded = nullptr;
+
+    if (fileName == nullptr)
+        return true;
+
+    char* text = LoadFileText(fileName);
+    if (text == nullptr)
+        return false;
+
+    unsigned char* bits = (unsigned char*)MemAlloc(RLIMGUI_GLYPH_PROFILE_BYTES);
+    int count = 0;
+
+    // pairs of first and last codepoint, up to the 0 terminator
+    const char* cursor = text;
+    unsigned long first = 0, last = 0;
+    while (ReadProfileNumber(&cursor, &first) && first != 0 && ReadProfileNumber(&cursor, &last))
+    {
+        for (unsigned long codepoint = first; codepoint <= last && codepoint < RLIMGUI_GLYPH_PROFILE_BYTES * 8; ++codepoint)
+            SetCodepointBit(bits, (unsigned int)codepoint);
+        count++;
+    }
+    UnloadFileText(text);
+
+    if (count == 0)
+    {
+        MemFree(bits);
+        return false;
+    }
+
+    // also for profiles that were written by hand
+    AddRequiredCodepoints(bits);
+
+    GlyphProfile.Loaded = bits;
+    return true;
+#endif
+}
+
+void rlImGuiSetDPIFontAtlases(bool enabled)
+{
+    ScaledFontAtlasCache* cache = &CurrentContext->ScaledFonts;
+
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+    ClearScaledFontAtlases(cache);
+
+    // the active fonts keep the density they were built with
+    cache->Scale = 1;
+    if (CurrentContext->ImGui != nullptr)
+    {
+        igSetCurrentContext(CurrentContext->ImGui);
+        ImFontAtlas* atlas = igGetIO()->Fonts;
+        if (atlas->ConfigData.Size > 0)
+            cache->Scale = atlas->ConfigData.Data[0].RasterizerDensity;
+    }
+#endif
+
+    cache->Enabled = enabled;
+}
+
+ImFont* rlImGuiLoadSDFFont(const char* fileName, float fontSize, const int* codepoints, int codepointCount)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    // custom glyph rects are gone from the ImGui 1.92 atlas API
+    return nullptr;
+#else
+    if (SDFFonts.Count == RLIMGUI_MAX_SDF_FONTS || !LoadSDFShader())
+        return nullptr;
+
+    int dataSize = 0;
+    unsigned char* fileData = LoadFileData(fileName, &dataSize);
+    if (fileData == nullptr)
+        return nullptr;
+
+    // raylib renders the distance fields, without codepoints it loads the 95 ASCII characters
+    int glyphCount = (codepointCount > 0) ? codepointCount : 95;
+    GlyphInfo* glyphs = LoadFontData(fileData, dataSize, (int)fontSize, (int*)codepoints, codepointCount, FONT_SDF);
+    if (glyphs == nullptr)
+    {
+        UnloadFileData(fileData);
+        return nullptr;
+    }
+
+    // ImGui loads the space glyph for the font metrics, the distance fields are packed as custom glyphs
+    static const ImWchar space[] = { 0x20, 0x20, 0 };
+    ImFontAtlas* atlas = ImFontAtlas_ImFontAtlas();
+    atlas->Flags |= ImFontAtlasFlags_NoMouseCursors;
+
+    ImFontConfig* config = ImFontConfig_ImFontConfig();
+    config->FontDataOwnedByAtlas = false;
+    ImFont* font = ImFontAtlas_AddFontFromMemoryTTF(atlas, fileData, dataSize, fontSize, config, space);
+    ImFontConfig_destroy(config);
+
+    int* rectIds = (int*)MemAlloc(sizeof(int) * glyphCount);
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        const GlyphInfo* glyph = &glyphs[i];
+        rectIds[i] = -1;
+        if (glyph->image.data == nullptr || glyph->value == 0x20)
+            continue;
+
+        ImVec2 offset = { (float)(glyph->offsetX - RLIMGUI_SDF_PADDING), (float)(glyph->offsetY - RLIMGUI_SDF_PADDING) };
+        rectIds[i] = ImFontAtlas_AddCustomRectFontGlyph(atlas, font, (ImWchar)glyph->value, glyph->image.width + RLIMGUI_SDF_PADDING * 2,
+            glyph->image.height + RLIMGUI_SDF_PADDING * 2, (float)glyph->advanceX, offset);
+    }
+
+    unsigned char* pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    ImFontAtlas_Build(atlas);
+    ImFontAtlas_GetTexDataAsAlpha8(atlas, &pixels, &width, &height, nullptr);
+
+    // the padding is left at 0, far outside of any outline
+    for (int i = 0; i < glyphCount; ++i)
+    {
+        if (rectIds[i] < 0)
+            continue;
+
+        const ImFontAtlasCustomRect* rect = ImFontAtlas_GetCustomRectByIndex(atlas, rectIds[i]);
+        const unsigned char* source = (const unsigned char*)glyphs[i].image.data;
+        unsigned char* dest = pixels + (rect->Y + RLIMGUI_SDF_PADDING) * width + rect->X + RLIMGUI_SDF_PADDING;
+        for (int y = 0; y < glyphs[i].image.height; ++y)
+            memcpy(dest + y * width, source + y * glyphs[i].image.width, glyphs[i].image.width);
+    }
+
+    Texture2D* texture = (Texture2D*)MemAlloc(sizeof(Texture2D));
+    texture->id = rlLoadTexture(pixels, width, height, PIXELFORMAT_UNCOMPRESSED_GRAYSCALE, 1);
+    texture->width = width;
+    texture->height = height;
+    texture->mipmaps = 1;
+    texture->format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE;
+
+    // distance fields only work when they are interpolated
+    SetTextureFilter(*texture, TEXTURE_FILTER_BILINEAR);
+    atlas->TexID = (ImTextureID)texture;
+
+    // the glyphs are in the texture now, the CPU pixels are not needed anymore. The input data stays, the font
+    // points to its config. A rebuild would pack the glyphs again without their distance fields, so the atlas is
+    // locked and ImGui asserts on any change to it
+    ImFontAtlas_ClearTexData(atlas);
+    atlas->Locked = true;
+    MemFree(rectIds);
+    UnloadFontData(glyphs, glyphCount);
+
+    SDFFonts.Atlases[SDFFonts.Count] = atlas;
+    SDFFonts.TextureIds[SDFFonts.Count] = texture->id;
+    SDFFonts.FileData[SDFFonts.Count] = fileData;
+    SDFFonts.Count++;
+    return font;
+#endif
+}
+
+void rlImGuiUnloadSDFFont(ImFont* font)
+{
+#if !defined(RLIMGUI_DYNAMIC_TEXTURES)
+    for (int i = 0; font != nullptr && i < SDFFonts.Count; ++i)
+    {
+        ImFontAtlas* atlas = SDFFonts.Atlases[i];
+        if (atlas != font->ContainerAtlas)
+            continue;
+
+        Texture2D* texture = (Texture2D*)atlas->TexID;
+        UnloadTexture(*texture);
+        MemFree(texture);
+        atlas->Locked = false;
+        ImFontAtlas_destroy(atlas);
+        UnloadFileData(SDFFonts.FileData[i]);
+
+        SDFFonts.Count--;
+        SDFFonts.Atlases[i] = SDFFonts.Atlases[SDFFonts.Count];
+        SDFFonts.TextureIds[i] = SDFFonts.TextureIds[SDFFonts.Count];
+        SDFFonts.FileData[i] = SDFFonts.FileData[SDFFonts.Count];
+        break;
+    }
+
+    if (SDFFonts.Count == 0)
+    {
+        if (SDFFonts.Shader.id != 0)
+            UnloadShader(SDFFonts.Shader);
+        SDFFonts = (SDFFontSet){ 0 };
+    }
+#endif
+}
+
+void rlImGuiSetSharedFontAtlas(bool enabled)
+{
+    SharedFonts.Enabled = enabled;
+}
+
+// ImGui 1.92 takes an ImTextureRef and dropped the tint and border colors from igImage
+static void DrawImage(const Texture* image, ImVec2 size, ImVec2 uv0, ImVec2 uv1)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    ImTextureRef texture = { nullptr, (ImTextureID)(uintptr_t)image };
+    igImage(texture, size, uv0, uv1);
+#else
+    igImage((ImTextureID)image, size, uv0, uv1, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+#endif
+}
+
+static bool DrawImageButton(const char* name, const Texture* image, ImVec2 size)
+{
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    ImTextureRef texture = { nullptr, (ImTextureID)(uintptr_t)image };
+    return igImageButton(name, texture, size, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+#else
+    return igImageButton(name, (ImTextureID)image, size, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+#endif
+}
+
+void rlImGuiImage(const Texture* image)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    DrawImage(image, (ImVec2){(float)image->width, (float)image->height}, (ImVec2){0, 0}, (ImVec2){1, 1});
+}
+
+bool rlImGuiImageButton(const char* name, const Texture* image)
+{
+    if (!image)
+        return false;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    return DrawImageButton(name, image, (ImVec2){(float)image->width, (float)image->height});
+}
+
+bool rlImGuiImageButtonSize(const char* name, const Texture* image, Vector2 size)
+{
+    if (!image)
+        return false;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    return DrawImageButton(name, image, (ImVec2){size.x, size.y});
+}
+
+void rlImGuiImageSize(const Texture* image, int width, int height)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    DrawImage(image, (ImVec2){(float)width, (float)height}, (ImVec2){0, 0}, (ImVec2){1, 1});
+}
+
+void rlImGuiImageSizeV(const Texture* image, Vector2 size)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    DrawImage(image, (ImVec2){size.x, size.y}, (ImVec2){0, 0}, (ImVec2){1, 1});
+}
+
+void rlImGuiImageRect(const Texture* image, int destWidth, int destHeight, Rectangle sourceRect)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    ImVec2 uv0;
+    ImVec2 uv1;
+
+    if (sourceRect.width < 0)
+    {
+        uv0.x = -((float)sourceRect.x / image->width);
+        uv1.x = (uv0.x - (float)(fabs(sourceRect.width) / image->width));
+    }
+    else
+    {
+        uv0.x = (float)sourceRect.x / image->width;
+        uv1.x = uv0.x + (float)(sourceRect.width / image->width);
+    }
+
+    if (sourceRect.height < 0)
+    {
+        uv0.y = -((float)sourceRect.y / image->height);
+        uv1.y = (uv0.y - (float)(fabs(sourceRect.height) / image->height));
+    }
+    else
+    {
+        uv0.y = (float)sourceRect.y / image->height;
+        uv1.y = uv0.y + (float)(sourceRect.height / image->height);
+    }
+
+    DrawImage(image, (ImVec2){(float)destWidth, (float)destHeight}, uv0, uv1);
+}
+
+void rlImGuiImageRenderTexture(const RenderTexture* image)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    rlImGuiImageRect(&image->texture, image->texture.width, image->texture.height, (Rectangle){ 0,0, (float)image->texture.width, -(float)image->texture.height });
+}
+
+void rlImGuiImageRenderTextureFit(const RenderTexture* image, bool center)
+{
+    if (!image)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    ImVec2 area;
+    igGetContentRegionAvail(&area);
+
+    float scale =  area.x / image->texture.width;
+
+    float y = image->texture.height * scale;
+    if (y > area.y)
+    {
+        scale = area.y / image->texture.height;
+    }
+
+    int sizeX = (int)(image->texture.width * scale);
+    int sizeY = (int)(image->texture.height * scale);
+
+    if (center)
+    {
+        igSetCursorPosX(0);
+        igSetCursorPosX(area.x/2 - sizeX/2);
+        igSetCursorPosY(igGetCursorPosY() + (area.y / 2 - sizeY / 2));
+    }
+
+    rlImGuiImageRect(&image->texture, sizeX, sizeY, (Rectangle){ 0,0, (float)(image->texture.width), -(float)(image->texture.height) });
+}
+
+// the icon is laid out as a size x size item, wider icons get the width of the glyph
+static void DrawIcon(const char* icon, float size, ImU32 color)
+{
+    if (icon == nullptr || size <= 0)
+        return;
+
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+#ifndef NO_FONT_AWESOME
+    // rasterized for the framebuffer, so icons stay sharp on high DPI displays
+    float scale = (igGetIO()->DisplayFramebufferScale.y > 0) ? igGetIO()->DisplayFramebufferScale.y : 1;
+    int pixelSize = (int)ceilf(size * scale);
+    if (pixelSize > RLIMGUI_ICON_PAGE_SIZE - 2)
+        pixelSize = RLIMGUI_ICON_PAGE_SIZE - 2;
+
+    int codepointSize = 0;
+    const IconGlyph* glyph = GetIconGlyph(GetCodepoint(icon, &codepointSize), pixelSize);
+
+    ImVec2 pos;
+    igGetCursorScreenPos(&pos);
+    float width = (glyph != nullptr) ? fmaxf(size, glyph->Advance / scale) : size;
+    igDummy((ImVec2){ width, size });
+
+    // a full atlas that can't clear a page leaves the icon out for this frame
+    if (glyph == nullptr || !igIsItemVisible())
+        return;
+
+    IconPage* page = CurrentContext->IconAtlas.Pages + glyph->Page;
+    page->LastUsed = CurrentContext->IconAtlas.Frame;
+    const Texture2D* texture = &page->Texture;
+
+    ImVec2 min = { pos.x + (width - glyph->Source.width / scale) * 0.5f, pos.y + glyph->Offset.y / scale };
+    ImVec2 max = { min.x + glyph->Source.width / scale, min.y + glyph->Source.height / scale };
+    ImVec2 uv0 = { glyph->Source.x / RLIMGUI_ICON_PAGE_SIZE, glyph->Source.y / RLIMGUI_ICON_PAGE_SIZE };
+    ImVec2 uv1 = { (glyph->Source.x + glyph->Source.width) / RLIMGUI_ICON_PAGE_SIZE, (glyph->Source.y + glyph->Source.height) / RLIMGUI_ICON_PAGE_SIZE };
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    ImTextureRef textureRef = { nullptr, (ImTextureID)(uintptr_t)texture };
+    ImDrawList_AddImage(igGetWindowDrawList(), textureRef, min, max, uv0, uv1, color);
+#else
+    ImDrawList_AddImage(igGetWindowDrawList(), (ImTextureID)texture, min, max, uv0, uv1, color);
+#endif
+#else
+    igDummy((ImVec2){ size, size });
+#endif
+}
+
+void rlImGuiIcon(const char* icon, float size)
+{
+    if (CurrentContext->ImGui)
+        igSetCurrentContext(CurrentContext->ImGui);
+
+    DrawIcon(icon, size, igGetColorU32_Col(ImGuiCol_Text, 1));
+}
+
+void rlImGuiIconColored(const char* icon, float size, Color color)
+{
+    DrawIcon(icon, size, ((ImU32)color.a << 24) | ((ImU32)color.b << 16) | ((ImU32)color.g << 8) | color.r);
+}
+
+// raw ImGui backend API
+bool ImGui_ImplRaylib_Init(void)
+{
+    SetupGlobals();
+
+    SetupMouseCursors();
+
+    SetupBackend();
+
+    return true;
+}
+
+void ImGui_ImplRaylib_BuildFontAtlas(void)
+{
+    ResetScaledFontAtlases();
+    ReloadFonts();
+}
+
+bool ImGui_ImplRaylib_BuildFontAtlasAsync(void (*setup)(ImFontAtlas* atlas, void* userData), void* userData)
+{
+    return rlImGuiReloadFontsAsync(setup, userData);
+}
+
+void ImGui_ImplRaylib_Shutdown()
+{
+    CancelFontBuild(&CurrentContext->FontBuild);
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    DestroyTextures();
+#else
+    // the shared font texture stays until the last context using it is shut down
+    if (!CurrentContext->SharedAtlas || SharedFonts.RefCount <= 1)
+        UnloadFontTexture(igGetIO()->Fonts);
+
+    ClearScaledFontAtlases(&CurrentContext->ScaledFonts);
+#endif
+
+    UnloadFrameCache(&CurrentContext->FrameCache);
+    UnloadWindowLayers(&CurrentContext->WindowLayers);
+#ifndef NO_FONT_AWESOME
+    UnloadIconAtlas();
+#endif
+
+    if (CurrentContext->BackendReady)
+    {
+        CurrentContext->BackendReady = false;
+        BackendRefCount--;
+    }
+
+    // other contexts still draw with the shared resources
+    if (BackendRefCount == 0)
+    {
+        UnloadRetainedBuffers();
+        UnloadDedicatedBatch();
+        UnloadVertexStreams();
+        UnloadSharpenFilter();
+        UnloadAlphaShader();
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+        UnloadTextureUploadBuffer();
+#endif
+#ifndef NO_FONT_AWESOME
+        UnloadIconFontData();
+#endif
+    }
+
+    if (CurrentContext->Resolution.Target.id != 0)
+        UnloadRenderTexture(CurrentContext->Resolution.Target);
+    CurrentContext->Resolution.Target = (RenderTexture2D){ 0 };
+}
+
+void ImGui_ImplRaylib_NewFrame(void)
+{
+    ApplyFontBuild(&CurrentContext->FontBuild);
+
+    WindowState window = SampleWindowState();
+    ImGuiNewFrame(&window, window.DeltaTime);
+}
+
+static void EnableCommandScissor(const ImDrawCmd* cmd)
+{
+    EnableScissor(cmd->ClipRect.x - CurrentContext->FrameTarget.DisplayPos.x, cmd->ClipRect.y - CurrentContext->FrameTarget.DisplayPos.y, cmd->ClipRect.z - cmd->ClipRect.x, cmd->ClipRect.w - cmd->ClipRect.y);
+}
+
+static bool SameClipRect(const ImDrawCmd* a, const ImDrawCmd* b)
+{
+    return a->ClipRect.x == b->ClipRect.x && a->ClipRect.y == b->ClipRect.y && a->ClipRect.z == b->ClipRect.z && a->ClipRect.w == b->ClipRect.w;
+}
+
+// two commands can be drawn as one submission when nothing between them changes the render state
+static bool CanMergeCommands(const ImDrawCmd* a, const ImDrawCmd* b)
+{
+    return a->UserCallback == nullptr && b->UserCallback == nullptr && GetCommandTextureId(a) == GetCommandTextureId(b) && SameClipRect(a, b);
+}
+
+static void RenderDrawDataImmediate(ImDrawData* draw_data)
+{
+    // every index becomes a vertex in the batch
+    if (draw_data->TotalIdxCount > CurrentContext->FrameStats.BatchHighWater)
+        CurrentContext->FrameStats.BatchHighWater = draw_data->TotalIdxCount;
+
+    // this draws whatever the game had pending in the default batch first
+    rlRenderBatch* batch = ReserveDedicatedBatch(draw_data->TotalIdxCount);
+    if (batch != nullptr)
+    {
+        rlSetRenderBatchActive(batch);
+        RenderState.TextureId = -1;
+    }
+    CurrentContext->FrameStats.BatchCapacity = DedicatedBatch.Elements * 4;
+
+    // the rlgl batch is only flushed when the scissor actually changes, so runs of commands with the same clip rect
+    // become a single submission, even across draw lists. Texture changes are handled inside the batch by rlgl.
+    const ImDrawCmd* lastCmd = nullptr;
+
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+
+        for (uint32_t idx = 0; idx < commandList->CmdBuffer.Size; ++idx)
+        {
+            ImDrawCmd* cmd = commandList->CmdBuffer.Data + idx;
+            CurrentContext->FrameStats.Commands++;
+
+            if (cmd->UserCallback != nullptr)
+            {
+                // callbacks draw with the default shader, like the rest of the application
+                SetBatchShaderState(GetDefaultShader());
+                FlushRenderBatch();
+                EnableCommandScissor(cmd);
+                cmd->UserCallback(commandList, cmd);
+
+                // the callback is free to change any state
+                FlushRenderBatch();
+                InvalidateRenderState();
+                lastCmd = nullptr;
+                continue;
+            }
+
+            if (!IsCommandVisible(cmd))
+            {
+                CurrentContext->FrameStats.CulledCommands++;
+                continue;
+            }
+
+            EnableCommandScissor(cmd);
+
+            if (lastCmd == nullptr || !CanMergeCommands(lastCmd, cmd))
+                CurrentContext->FrameStats.Submissions++;
+
+            ImGuiRenderTriangles(cmd->ElemCount, cmd->IdxOffset, commandList->IdxBuffer.Data, commandList->VtxBuffer.Data + cmd->VtxOffset, GetCommandTexture(cmd));
+            lastCmd = cmd;
+        }
+    }
+
+    SetBatchShaderState(GetDefaultShader());
+    FlushRenderBatch();
+    if (batch != nullptr)
+        rlSetRenderBatchActive(nullptr);
+}
+
+static bool RenderDrawDataRetained(ImDrawData* draw_data)
+{
+    // rlgl only issues 16 bit indexed draws, 32 bit index builds use the immediate path
+    if (sizeof(ImDrawIdx) != sizeof(unsigned short))
+        return false;
+
+    if (!ReserveRetainedBuffers(draw_data->TotalVtxCount, draw_data->TotalIdxCount))
+        return false;
+
+    // upload every list back to back, so the whole frame is two buffer updates per list and no per vertex calls
+    rlEnableVertexArray(Retained.VaoId);
+
+    int vtxBase = 0;
+    int idxBase = 0;
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+
+        rlUpdateVertexBuffer(Retained.VboId, commandList->VtxBuffer.Data, commandList->VtxBuffer.Size * (int)sizeof(ImDrawVert), vtxBase * (int)sizeof(ImDrawVert));
+        rlUpdateVertexBufferElements(Retained.IboId, commandList->IdxBuffer.Data, commandList->IdxBuffer.Size * (int)sizeof(ImDrawIdx), idxBase * (int)sizeof(ImDrawIdx));
+
+        vtxBase += commandList->VtxBuffer.Size;
+        idxBase += commandList->IdxBuffer.Size;
+    }
+
+    const int* shaderLocs = rlGetShaderLocsDefault();
+    BeginBufferShader();
+
+    vtxBase = 0;
+    idxBase = 0;
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+
+        // rlgl has no base vertex draw, so VtxOffset is applied by moving the attribute pointers
+        int layoutBase = -1;
+        rlEnableVertexArray(Retained.VaoId);
+
+        for (uint32_t idx = 0; idx < commandList->CmdBuffer.Size; ++idx)
+        {
+            ImDrawCmd* cmd = commandList->CmdBuffer.Data + idx;
+            CurrentContext->FrameStats.Commands++;
+
+            if (cmd->UserCallback != nullptr)
+            {
+                // callbacks may draw with rlgl, so give them back the default state and restore ours afterwards
+                EndBufferShader();
+                EnableCommandScissor(cmd);
+                cmd->UserCallback(commandList, cmd);
+                FlushRenderBatch();
+                InvalidateRenderState();
+
+                BeginBufferShader();
+                rlEnableVertexArray(Retained.VaoId);
+                layoutBase = -1;
+                continue;
+            }
+
+            if (!IsCommandVisible(cmd))
+            {
+                CurrentContext->FrameStats.CulledCommands++;
+                continue;
+            }
 
-    igSetCurrentContext(GlobalContext);
-    ImGui_ImplRaylib_Shutdown();
+            EnableCommandScissor(cmd);
+
+            // indices of consecutive commands are contiguous in the list, so matching neighbours extend one draw.
+            // Lists can't be merged with each other here, each one has its own base vertex.
+            ImDrawCmd merged = *cmd;
+            while (idx + 1 < commandList->CmdBuffer.Size)
+            {
+                const ImDrawCmd* next = cmd + 1;
+                if (!CanMergeCommands(&merged, next) || next->VtxOffset != merged.VtxOffset || next->IdxOffset != merged.IdxOffset + merged.ElemCount)
+                    break;
+
+                merged.ElemCount += next->ElemCount;
+                CurrentContext->FrameStats.Commands++;
+                ++cmd;
+                ++idx;
+            }
+
+            if (layoutBase != vtxBase + (int)merged.VtxOffset)
+            {
+                layoutBase = vtxBase + (int)merged.VtxOffset;
+                SetRetainedVertexLayout(shaderLocs, layoutBase);
+            }
+
+            CurrentContext->FrameStats.Submissions++;
+            RetainedDrawCommand(&merged, idxBase);
+        }
 
-    igDestroyContext(GlobalContext);
-    GlobalContext = nullptr;
+        vtxBase += commandList->VtxBuffer.Size;
+        idxBase += commandList->IdxBuffer.Size;
+    }
+
+    EndBufferShader();
+    return true;
 }
 
-void rlImGuiImage(const Texture* image)
+static StreamDraw* PushStreamDraw(int* drawCount)
 {
-    if (!image)
-        return;
-
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+    if (*drawCount == StreamDrawCapacity)
+    {
+        StreamDrawCapacity = GrowCapacity(StreamDrawCapacity, 64);
+        StreamDraws = (StreamDraw*)MemRealloc(StreamDraws, StreamDrawCapacity * sizeof(StreamDraw));
+    }
 
-    igImage((ImTextureID)image, (ImVec2){(float)image->width, (float)image->height}, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+    return StreamDraws + (*drawCount)++;
 }
 
-bool rlImGuiImageButton(const char* name, const Texture* image)
+static bool RenderDrawDataStreamed(ImDrawData* draw_data)
 {
-    if (!image)
+    if (!ReserveVertexStreams(draw_data->TotalIdxCount))
         return false;
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+    SelectStreamKernel();
+
+    // de-index every visible command into the streams. Consecutive commands with the same texture and clip rect
+    // end up next to each other in the streams, so they extend the same draw, even across draw lists.
+    int vertexCount = 0;
+    int drawCount = 0;
+    StreamDraw* lastDraw = nullptr;
+
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+
+        for (uint32_t idx = 0; idx < commandList->CmdBuffer.Size; ++idx)
+        {
+            const ImDrawCmd* cmd = commandList->CmdBuffer.Data + idx;
+            CurrentContext->FrameStats.Commands++;
+
+            if (cmd->UserCallback != nullptr)
+            {
+                StreamDraw* draw = PushStreamDraw(&drawCount);
+                *draw = (StreamDraw){ commandList, cmd, 0, 0 };
+                lastDraw = nullptr;
+                continue;
+            }
+
+            if (!IsCommandVisible(cmd))
+            {
+                CurrentContext->FrameStats.CulledCommands++;
+                continue;
+            }
+
+            int count = (int)cmd->ElemCount;
+            StreamKernel(commandList->VtxBuffer.Data + cmd->VtxOffset, commandList->IdxBuffer.Data + cmd->IdxOffset, count,
+                Streams.Positions + vertexCount * 2, Streams.TexCoords + vertexCount * 2, Streams.Colors + vertexCount);
+
+            if (lastDraw != nullptr && CanMergeCommands(lastDraw->Cmd, cmd))
+            {
+                lastDraw->VertexCount += count;
+            }
+            else
+            {
+                lastDraw = PushStreamDraw(&drawCount);
+                *lastDraw = (StreamDraw){ commandList, cmd, vertexCount, count };
+            }
+
+            vertexCount += count;
+        }
+    }
+
+    rlUpdateVertexBuffer(Streams.PositionVboId, Streams.Positions, vertexCount * 2 * (int)sizeof(float), 0);
+    rlUpdateVertexBuffer(Streams.TexCoordVboId, Streams.TexCoords, vertexCount * 2 * (int)sizeof(float), 0);
+    rlUpdateVertexBuffer(Streams.ColorVboId, Streams.Colors, vertexCount * (int)sizeof(unsigned int), 0);
+
+    BeginBufferShader();
+    rlEnableVertexArray(Streams.VaoId);
+
+    for (int i = 0; i < drawCount; ++i)
+    {
+        const StreamDraw* draw = StreamDraws + i;
+
+        if (draw->Cmd->UserCallback != nullptr)
+        {
+            EndBufferShader();
+            EnableCommandScissor(draw->Cmd);
+            draw->Cmd->UserCallback(draw->List, draw->Cmd);
+            FlushRenderBatch();
+            InvalidateRenderState();
+
+            BeginBufferShader();
+            rlEnableVertexArray(Streams.VaoId);
+            continue;
+        }
 
-    return igImageButton(name, (ImTextureID)image, (ImVec2){(float)image->width, (float)image->height}, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+        EnableCommandScissor(draw->Cmd);
+
+        Texture* texture = GetCommandTexture(draw->Cmd);
+        SetShaderTextureState((texture == nullptr) ? rlGetTextureIdDefault() : texture->id);
+
+        CurrentContext->FrameStats.Submissions++;
+        rlDrawVertexArray(draw->FirstVertex, draw->VertexCount);
+    }
+
+    EndBufferShader();
+    return true;
 }
 
-bool rlImGuiImageButtonSize(const char* name, const Texture* image, Vector2 size)
+// renders the draw data into whatever target is currently bound
+static void RenderDrawDataToTarget(ImDrawData* draw_data, int blendMode)
 {
-    if (!image)
-        return false;
+    rlDrawRenderBatchActive();
+    InvalidateRenderState();
+
+    SetCullingState(false);
+    if (blendMode != RLIMGUI_BLEND_TARGET)
+        SetBlendModeState(blendMode);
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+    // the GPU buffer paths fall back to immediate mode when the GL version can't support them
+    bool rendered = false;
+    if (CurrentContext->RenderMode == RLIMGUI_RENDER_RETAINED)
+        rendered = RenderDrawDataRetained(draw_data);
+    else if (CurrentContext->RenderMode == RLIMGUI_RENDER_STREAMED)
+        rendered = RenderDrawDataStreamed(draw_data);
 
-    return igImageButton(name, (ImTextureID)image, (ImVec2){size.x, size.y}, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+    if (!rendered)
+        RenderDrawDataImmediate(draw_data);
+
+    rlSetTexture(0);
+    DisableScissorState();
+    SetCullingState(true);
 }
 
-void rlImGuiImageSize(const Texture* image, int width, int height)
+// hashes the geometry and commands of one draw list, returns false if the list can't be cached
+static bool HashDrawList(const ImDrawList* commandList, uint64_t* hash)
 {
-    if (!image)
-        return;
+    *hash = HashBytes(*hash, commandList->VtxBuffer.Data, commandList->VtxBuffer.Size * sizeof(ImDrawVert));
+    *hash = HashBytes(*hash, commandList->IdxBuffer.Data, commandList->IdxBuffer.Size * sizeof(ImDrawIdx));
+
+    for (int c = 0; c < commandList->CmdBuffer.Size; ++c)
+    {
+        const ImDrawCmd* cmd = commandList->CmdBuffer.Data + c;
+
+        // callbacks have to run every frame
+        if (cmd->UserCallback != nullptr)
+            return false;
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+        // the pointer alone is not enough, a reloaded texture can end up at the same address
+        const Texture* texture = GetCommandTexture(cmd);
+        unsigned int key[5] = { cmd->VtxOffset, cmd->IdxOffset, cmd->ElemCount, texture ? texture->id : 0, texture ? (unsigned int)(texture->width ^ (texture->height << 16)) : 0 };
+
+        *hash = HashBytes(*hash, &cmd->ClipRect, sizeof(ImVec4));
+        ImTextureID textureId = GetCommandTextureId(cmd);
+        *hash = HashBytes(*hash, &textureId, sizeof(ImTextureID));
+        *hash = HashBytes(*hash, key, sizeof(key));
+    }
 
-    igImage((ImTextureID)image, (ImVec2){(float)width, (float)height}, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+    return true;
 }
 
-void rlImGuiImageSizeV(const Texture* image, Vector2 size)
+// hashes everything that affects the output of a frame, returns false if the frame can't be cached
+static bool HashDrawData(const ImDrawData* draw_data, uint64_t* outHash)
 {
-    if (!image)
-        return;
+    uint64_t hash = 0xCBF29CE484222325ull;
+    hash = HashBytes(hash, &draw_data->DisplayPos, sizeof(ImVec2));
+    hash = HashBytes(hash, &draw_data->DisplaySize, sizeof(ImVec2));
+    hash = HashBytes(hash, &CurrentContext->FrameTarget.FramebufferScale, sizeof(ImVec2));
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    {
+        if (!HashDrawList(draw_data->CmdLists.Data[l], &hash))
+            return false;
+    }
 
-    igImage((ImTextureID)image, (ImVec2){size.x, size.y}, (ImVec2){0, 0}, (ImVec2){1, 1}, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+    *outHash = hash;
+    return true;
 }
 
-void rlImGuiImageRect(const Texture* image, int destWidth, int destHeight, Rectangle sourceRect)
+// draws the top left width x height pixels of an offscreen layer rendered with the layer blend mode
+static void CompositeLayer(Texture2D texture, int width, int height, Rectangle dest)
 {
-    if (!image)
-        return;
+    DisableScissorState();
+    SetBlendModeState(RL_BLEND_ALPHA_PREMULTIPLY);
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
+    // render textures are upside down, the top of the layer is at the end of the texture
+    Rectangle source = { 0, (float)(texture.height - height), (float)width, -(float)height };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0, 0 }, 0, WHITE);
+    FlushRenderBatch();
 
-    ImVec2 uv0;
-    ImVec2 uv1;
+    SetBlendModeState(RL_BLEND_ALPHA);
+}
 
-    if (sourceRect.width < 0)
-    {
-        uv0.x = -((float)sourceRect.x / image->width);
-        uv1.x = (uv0.x - (float)(fabs(sourceRect.width) / image->width));
-    }
-    else
-    {
-        uv0.x = (float)sourceRect.x / image->width;
-        uv1.x = uv0.x + (float)(sourceRect.width / image->width);
-    }
+// makes sure an offscreen copy of the whole display exists at the context's resolution scale, returns false if the display is empty
+static bool ReserveDisplayTarget(RenderTexture2D* target, float resolutionScale)
+{
+    int width = (int)ceilf(CurrentContext->FrameTarget.DisplaySize.x * CurrentContext->FrameTarget.FramebufferScale.x * resolutionScale);
+    int height = (int)ceilf(CurrentContext->FrameTarget.DisplaySize.y * CurrentContext->FrameTarget.FramebufferScale.y * resolutionScale);
+    if (width <= 0 || height <= 0)
+        return false;
 
-    if (sourceRect.height < 0)
-    {
-        uv0.y = -((float)sourceRect.y / image->height);
-        uv1.y = (uv0.y - (float)(fabs(sourceRect.height) / image->height));
-    }
-    else
+    if (target->id != 0 && target->texture.width == width && target->texture.height == height)
+        return true;
+
+    if (target->id != 0)
+        UnloadRenderTexture(*target);
+
+    *target = LoadRenderTexture(width, height);
+
+    // a scaled copy is stretched over the display, at full resolution the texels map 1:1 and filtering changes nothing
+    SetTextureFilter(target->texture, TEXTURE_FILTER_BILINEAR);
+    return true;
+}
+
+// draws the whole display into an offscreen target. ImGui units are mapped to target pixels, so the scissor rects follow the target resolution
+static void RenderDrawDataToDisplayTarget(ImDrawData* draw_data, RenderTexture2D target)
+{
+    RenderTargetInfo outerTarget = CurrentContext->FrameTarget;
+    CurrentContext->FrameTarget.FramebufferScale = (ImVec2){ target.texture.width / CurrentContext->FrameTarget.DisplaySize.x, target.texture.height / CurrentContext->FrameTarget.DisplaySize.y };
+
+    BeginOffscreenTarget(target, CurrentContext->FrameTarget.DisplayPos, CurrentContext->FrameTarget.FramebufferScale);
+    RenderDrawDataToTarget(draw_data, RL_BLEND_CUSTOM_SEPARATE);
+    EndOffscreenTarget();
+
+    CurrentContext->FrameTarget = outerTarget;
+}
+
+// stretches an offscreen copy of the display over the display, sharpened when it has fewer pixels than the framebuffer
+static void CompositeDisplayTarget(RenderTexture2D target)
+{
+    Rectangle dest = { CurrentContext->FrameTarget.DisplayPos.x, CurrentContext->FrameTarget.DisplayPos.y, CurrentContext->FrameTarget.DisplaySize.x, CurrentContext->FrameTarget.DisplaySize.y };
+
+    float sharpness = CurrentContext->Resolution.Sharpness;
+    bool upscaled = target.texture.width < (int)(dest.width * CurrentContext->FrameTarget.FramebufferScale.x);
+    bool sharpen = sharpness > 0 && upscaled && LoadSharpenFilter();
+
+    InvalidateRenderState();
+    if (sharpen)
     {
-        uv0.y = (float)sourceRect.y / image->height;
-        uv1.y = uv0.y + (float)(sourceRect.height / image->height);
+        Vector2 texelSize = { 1.0f / target.texture.width, 1.0f / target.texture.height };
+        BeginShaderMode(Sharpen.Shader);
+        SetShaderValue(Sharpen.Shader, Sharpen.TexelSizeLoc, &texelSize, SHADER_UNIFORM_VEC2);
+        SetShaderValue(Sharpen.Shader, Sharpen.SharpnessLoc, &sharpness, SHADER_UNIFORM_FLOAT);
     }
 
-    igImage((ImTextureID)image, (ImVec2){(float)destWidth, (float)destHeight}, uv0, uv1, (ImVec4){1, 1, 1, 1}, (ImVec4){0, 0, 0, 0});
+    CompositeLayer(target.texture, target.texture.width, target.texture.height, dest);
+
+    if (sharpen)
+        EndShaderMode();
 }
 
-void rlImGuiImageRenderTexture(const RenderTexture* image)
+static void RenderDrawDataScaled(ImDrawData* draw_data, float resolutionScale)
 {
-    if (!image)
+    if (!ReserveDisplayTarget(&CurrentContext->Resolution.Target, resolutionScale))
         return;
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
-
-    rlImGuiImageRect(&image->texture, image->texture.width, image->texture.height, (Rectangle){ 0,0, (float)image->texture.width, -(float)image->texture.height });
+    RenderDrawDataToDisplayTarget(draw_data, CurrentContext->Resolution.Target);
+    CompositeDisplayTarget(CurrentContext->Resolution.Target);
 }
 
-void rlImGuiImageRenderTextureFit(const RenderTexture* image, bool center)
+static void RenderDrawDataCached(ImDrawData* draw_data, float resolutionScale)
 {
-    if (!image)
+    uint64_t hash = 0;
+    if (!HashDrawData(draw_data, &hash))
+    {
+        CurrentContext->FrameCache.Valid = false;
+        CurrentContext->FrameCache.Misses++;
+        if (resolutionScale < 1)
+            RenderDrawDataScaled(draw_data, resolutionScale);
+        else
+            RenderDrawDataToTarget(draw_data, RLIMGUI_BLEND_TARGET);
         return;
+    }
 
-    if (GlobalContext)
-        igSetCurrentContext(GlobalContext);
-
-    ImVec2 area;
-    igGetContentRegionAvail(&area);
+    // the cached frame is kept at the scaled resolution, so a hit costs the same fill rate as a scaled frame
+    RenderTexture2D previousTarget = CurrentContext->FrameCache.Target;
+    if (!ReserveDisplayTarget(&CurrentContext->FrameCache.Target, resolutionScale))
+        return;
 
-    float scale =  area.x / image->texture.width;
+    // the target is only reallocated when its size changes
+    RenderTexture2D target = CurrentContext->FrameCache.Target;
+    if (previousTarget.id == 0 || previousTarget.texture.width != target.texture.width || previousTarget.texture.height != target.texture.height)
+        CurrentContext->FrameCache.Valid = false;
 
-    float y = image->texture.height * scale;
-    if (y > area.y)
+    if (CurrentContext->FrameCache.Valid && CurrentContext->FrameCache.Hash == hash)
     {
-        scale = area.y / image->texture.height;
+        CurrentContext->FrameCache.Hits++;
+        CurrentContext->FrameStats.FrameCacheHit = 1;
     }
+    else
+    {
+        CurrentContext->FrameCache.Misses++;
 
-    int sizeX = (int)(image->texture.width * scale);
-    int sizeY = (int)(image->texture.height * scale);
+        RenderDrawDataToDisplayTarget(draw_data, CurrentContext->FrameCache.Target);
 
-    if (center)
-    {
-        igSetCursorPosX(0);
-        igSetCursorPosX(area.x/2 - sizeX/2);
-        igSetCursorPosY(igGetCursorPosY() + (area.y / 2 - sizeY / 2));
+        CurrentContext->FrameCache.Hash = hash;
+        CurrentContext->FrameCache.Valid = true;
     }
 
-    rlImGuiImageRect(&image->texture, sizeX, sizeY, (Rectangle){ 0,0, (float)(image->texture.width), -(float)(image->texture.height) });
+    CompositeDisplayTarget(CurrentContext->FrameCache.Target);
 }
 
-// raw ImGui backend API
-bool ImGui_ImplRaylib_Init(void)
+// a view of a range of draw lists, so runs of live lists can go through the normal render paths
+static ImDrawData SubDrawData(const ImDrawData* draw_data, int first, int count)
 {
-    SetupGlobals();
+    ImDrawData subData = *draw_data;
+    subData.CmdListsCount = count;
+    subData.CmdLists.Size = count;
+    subData.CmdLists.Capacity = count;
+    subData.CmdLists.Data = draw_data->CmdLists.Data + first;
+    subData.TotalVtxCount = 0;
+    subData.TotalIdxCount = 0;
+
+    for (int l = 0; l < count; ++l)
+    {
+        subData.TotalVtxCount += subData.CmdLists.Data[l]->VtxBuffer.Size;
+        subData.TotalIdxCount += subData.CmdLists.Data[l]->IdxBuffer.Size;
+    }
 
-    SetupMouseCursors();
+    return subData;
+}
 
-    SetupBackend();
+static uint64_t HashOwnerName(const ImDrawList* commandList)
+{
+    const char* name = commandList->_OwnerName;
+    return (name == nullptr) ? 0 : HashBytes(0, name, strlen(name));
+}
 
-    return true;
+static WindowLayer* FindWindowLayer(const ImDrawList* commandList, uint64_t ownerHash)
+{
+    for (int i = 0; i < RLIMGUI_MAX_WINDOW_LAYERS; ++i)
+    {
+        if (CurrentContext->WindowLayers.Layers[i].List == commandList && CurrentContext->WindowLayers.Layers[i].OwnerHash == ownerHash)
+            return CurrentContext->WindowLayers.Layers + i;
+    }
+    return nullptr;
 }
 
-void ImGui_ImplRaylib_BuildFontAtlas(void)
+// takes an unused slot, or the least recently used one. Slots given to a list this frame are never taken, when all of
+// them are the list stays live.
+static WindowLayer* AcquireWindowLayer(const ImDrawList* commandList, uint64_t ownerHash)
 {
-    ReloadFonts();
+    WindowLayer* oldest = nullptr;
+    for (int i = 0; i < RLIMGUI_MAX_WINDOW_LAYERS; ++i)
+    {
+        WindowLayer* layer = CurrentContext->WindowLayers.Layers + i;
+        if (layer->List == nullptr)
+        {
+            oldest = layer;
+            break;
+        }
+        if (layer->LastUsedFrame == CurrentContext->WindowLayers.FrameIndex)
+            continue;
+        if (oldest == nullptr || layer->LastUsedFrame < oldest->LastUsedFrame)
+            oldest = layer;
+    }
+
+    if (oldest == nullptr)
+        return nullptr;
+
+    UnloadWindowLayer(oldest);
+    oldest->List = commandList;
+    oldest->OwnerHash = ownerHash;
+    return oldest;
 }
 
-void ImGui_ImplRaylib_Shutdown()
+// the area a list can draw to is the union of its clip rects, limited to the display
+static bool GetDrawListBounds(const ImDrawList* commandList, Rectangle* bounds)
 {
-    ImGuiIO* io =igGetIO();
-    Texture2D* fontTexture = (Texture2D*)io->Fonts->TexID;
+    float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
 
-    if (fontTexture)
+    for (int c = 0; c < commandList->CmdBuffer.Size; ++c)
     {
-        UnloadTexture(*fontTexture);
-        MemFree(fontTexture);
+        const ImDrawCmd* cmd = commandList->CmdBuffer.Data + c;
+        if (!IsCommandVisible(cmd))
+            continue;
+
+        minX = fminf(minX, cmd->ClipRect.x);
+        minY = fminf(minY, cmd->ClipRect.y);
+        maxX = fmaxf(maxX, cmd->ClipRect.z);
+        maxY = fmaxf(maxY, cmd->ClipRect.w);
     }
 
-    io->Fonts->TexID = 0;
+    // snap to whole units, so the layer maps to whole pixels at integer scales
+    minX = floorf(fmaxf(minX, CurrentContext->FrameTarget.DisplayPos.x));
+    minY = floorf(fmaxf(minY, CurrentContext->FrameTarget.DisplayPos.y));
+    maxX = ceilf(fminf(maxX, CurrentContext->FrameTarget.DisplayPos.x + CurrentContext->FrameTarget.DisplaySize.x));
+    maxY = ceilf(fminf(maxY, CurrentContext->FrameTarget.DisplayPos.y + CurrentContext->FrameTarget.DisplaySize.y));
+
+    if (maxX <= minX || maxY <= minY)
+        return false;
+
+    *bounds = (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+    return true;
 }
 
-void ImGui_ImplRaylib_NewFrame(void)
+static void RenderWindowLayer(const ImDrawData* draw_data, int listIndex, WindowLayer* layer)
 {
-    ImGuiNewFrame(GetFrameTime());
+    int width = (int)ceilf(layer->Bounds.width * CurrentContext->FrameTarget.FramebufferScale.x);
+    int height = (int)ceilf(layer->Bounds.height * CurrentContext->FrameTarget.FramebufferScale.y);
+
+    // the texture grows and shrinks in steps, so resizing a window only reallocates it every few pixels
+    int textureWidth = (width + RLIMGUI_LAYER_SIZE_STEP - 1) / RLIMGUI_LAYER_SIZE_STEP * RLIMGUI_LAYER_SIZE_STEP;
+    int textureHeight = (height + RLIMGUI_LAYER_SIZE_STEP - 1) / RLIMGUI_LAYER_SIZE_STEP * RLIMGUI_LAYER_SIZE_STEP;
+    if (layer->Target.id == 0 || layer->Target.texture.width != textureWidth || layer->Target.texture.height != textureHeight)
+    {
+        if (layer->Target.id != 0)
+            UnloadRenderTexture(layer->Target);
+        layer->Target = LoadRenderTexture(textureWidth, textureHeight);
+    }
+    layer->Width = width;
+    layer->Height = height;
+
+    // the layer is its own small display, so culling and scissor work relative to it
+    RenderTargetInfo outerTarget = CurrentContext->FrameTarget;
+    CurrentContext->FrameTarget.DisplayPos = (ImVec2){ layer->Bounds.x, layer->Bounds.y };
+    CurrentContext->FrameTarget.DisplaySize = (ImVec2){ layer->Target.texture.width / outerTarget.FramebufferScale.x, layer->Target.texture.height / outerTarget.FramebufferScale.y };
+
+    ImDrawData listData = SubDrawData(draw_data, listIndex, 1);
+    BeginOffscreenTarget(layer->Target, CurrentContext->FrameTarget.DisplayPos, CurrentContext->FrameTarget.FramebufferScale);
+    RenderDrawDataToTarget(&listData, RL_BLEND_CUSTOM_SEPARATE);
+    EndOffscreenTarget();
+
+    CurrentContext->FrameTarget = outerTarget;
+    layer->Valid = true;
+    CurrentContext->FrameStats.WindowLayersUpdated++;
 }
 
-void ImGui_ImplRaylib_RenderDrawData(ImDrawData* draw_data)
+static void RenderDrawDataLayered(ImDrawData* draw_data)
 {
-    rlDrawRenderBatchActive();
-    rlDisableBackfaceCulling();
+    CurrentContext->WindowLayers.FrameIndex++;
 
-    for (int l = 0; l < draw_data->CmdListsCount; ++l)
+    // decide which lists come from a layer this frame. All layers are rendered before anything is drawn to the
+    // outer target, texture mode can't be nested inside the composition pass.
+    for (int l = 0; l < draw_data->CmdListsCount && l < RLIMGUI_MAX_LAYERED_LISTS; ++l)
     {
         const ImDrawList* commandList = draw_data->CmdLists.Data[l];
+        CurrentContext->WindowLayers.ListLayers[l] = nullptr;
 
-        for (uint32_t idx = 0; idx < commandList->CmdBuffer.Size; ++idx)
+        uint64_t hash = 0xCBF29CE484222325ull;
+        if (commandList->VtxBuffer.Size < RLIMGUI_LAYER_MIN_VERTICES || !HashDrawList(commandList, &hash))
+            continue;
+
+        uint64_t ownerHash = HashOwnerName(commandList);
+        WindowLayer* layer = FindWindowLayer(commandList, ownerHash);
+        if (layer == nullptr)
+            layer = AcquireWindowLayer(commandList, ownerHash);
+        if (layer == nullptr)
+            continue;
+        layer->LastUsedFrame = CurrentContext->WindowLayers.FrameIndex;
+
+        if (layer->ContentHash != hash)
         {
-            ImDrawCmd* cmd = commandList->CmdBuffer.Data + idx;
-            EnableScissor(cmd->ClipRect.x - draw_data->DisplayPos.x, cmd->ClipRect.y - draw_data->DisplayPos.y, cmd->ClipRect.z - (cmd->ClipRect.x - draw_data->DisplayPos.x), cmd->ClipRect.w - (cmd->ClipRect.y - draw_data->DisplayPos.y));
-            if (cmd->UserCallback != nullptr)
-            {
-                cmd->UserCallback(commandList, cmd);
+            // content that changes every frame would be rendered twice, it stays live until it settles
+            layer->ContentHash = hash;
+            layer->StableFrames = 0;
+            layer->Valid = false;
+            continue;
+        }
 
+        if (++layer->StableFrames < RLIMGUI_LAYER_STABLE_FRAMES)
+            continue;
+
+        if (!layer->Valid)
+        {
+            if (!GetDrawListBounds(commandList, &layer->Bounds))
                 continue;
-            }
+            RenderWindowLayer(draw_data, l, layer);
+        }
 
-            ImGuiRenderTriangles(cmd->ElemCount, cmd->IdxOffset, commandList->IdxBuffer.Data, commandList->VtxBuffer.Data, (Texture2D*)cmd->TextureId);
-            rlDrawRenderBatchActive();
+        CurrentContext->WindowLayers.ListLayers[l] = layer;
+    }
+
+    // draw in list order, so layers and live lists overlap the same way they would without layers.
+    // Runs of live lists go through the render paths as one draw data.
+    int liveStart = 0;
+    for (int l = 0; l <= draw_data->CmdListsCount; ++l)
+    {
+        WindowLayer* layer = (l < draw_data->CmdListsCount && l < RLIMGUI_MAX_LAYERED_LISTS) ? CurrentContext->WindowLayers.ListLayers[l] : nullptr;
+        if (layer == nullptr && l < draw_data->CmdListsCount)
+            continue;
+
+        if (l > liveStart)
+        {
+            ImDrawData liveData = SubDrawData(draw_data, liveStart, l - liveStart);
+            RenderDrawDataToTarget(&liveData, RLIMGUI_BLEND_TARGET);
+        }
+        liveStart = l + 1;
+
+        if (layer != nullptr)
+        {
+            InvalidateRenderState();
+            CompositeLayer(layer->Target.texture, layer->Width, layer->Height, layer->Bounds);
+            CurrentContext->FrameStats.WindowLayersDrawn++;
         }
     }
+}
 
-    rlSetTexture(0);
-    rlDisableScissorTest();
-    rlEnableBackfaceCulling();
+void ImGui_ImplRaylib_RenderDrawData(ImDrawData* draw_data)
+{
+    double renderStart = GetTime();
+
+    int batchHighWater = CurrentContext->FrameStats.BatchHighWater;
+    CurrentContext->FrameStats = (rlImGuiRenderStats){ 0 };
+    CurrentContext->FrameStats.BatchHighWater = batchHighWater;
+    CurrentContext->FrameStats.BuildMilliseconds = CurrentContext->FrameBuildMilliseconds;
+    CurrentContext->FrameStats.FrameLatency = CurrentContext->FrameLatency;
+    CurrentContext->FrameStats.DrawLists = draw_data->CmdListsCount;
+    CurrentContext->FrameStats.Vertices = draw_data->TotalVtxCount;
+    CurrentContext->FrameStats.Indices = draw_data->TotalIdxCount;
+
+#ifndef NO_FONT_AWESOME
+    // counts the frames drawn for this context, the icon pages age with them
+    CurrentContext->IconAtlas.Frame++;
+#endif
+
+#if defined(RLIMGUI_DYNAMIC_TEXTURES)
+    UpdateTextures(draw_data);
+#else
+    if (GlyphProfile.Recording)
+        RecordGlyphs(draw_data);
+#endif
+
+    SetupFrameTarget(draw_data);
+
+    // render textures can't be nested, so a context drawn to its own target doesn't use the offscreen caches or scaling
+    float resolutionScale = (ActiveRenderTarget == nullptr) ? GetResolutionScale(CurrentContext) : 1;
+    CurrentContext->FrameStats.ResolutionScale = resolutionScale;
+
+    if (CurrentContext->FrameCache.Enabled && ActiveRenderTarget == nullptr)
+        RenderDrawDataCached(draw_data, resolutionScale);
+    else if (resolutionScale < 1)
+        RenderDrawDataScaled(draw_data, resolutionScale);
+    else if (CurrentContext->WindowLayers.Enabled && ActiveRenderTarget == nullptr)
+        RenderDrawDataLayered(draw_data);
+    else
+        RenderDrawDataToTarget(draw_data, (ActiveRenderTarget != nullptr) ? RL_BLEND_CUSTOM_SEPARATE : RLIMGUI_BLEND_TARGET);
+
+    if (BlendModeChanged)
+    {
+        FlushRenderBatch();
+        rlSetBlendMode(RL_BLEND_ALPHA);
+        BlendModeChanged = false;
+    }
+
+    CurrentContext->FrameStats.RenderMilliseconds = (float)((GetTime() - renderStart) * 1000.0);
 }
 
-void HandleGamepadButtonEvent(ImGuiIO* io, GamepadButton button, ImGuiKey key)
+bool HandleGamepadButtonEvent(ImGuiIO* io, GamepadButton button, ImGuiKey key)
 {
     if (IsGamepadButtonPressed(0, button))
         ImGuiIO_AddKeyEvent(io, key, true);
     else if (IsGamepadButtonReleased(0, button))
         ImGuiIO_AddKeyEvent(io, key, false);
+    else
+        return false;
+
+    return true;
 }
 
-void HandleGamepadStickEvent(ImGuiIO* io, GamepadAxis axis, ImGuiKey negKey, ImGuiKey posKey)
+bool HandleGamepadStickEvent(ImGuiIO* io, GamepadAxis axis, ImGuiKey negKey, ImGuiKey posKey)
 {
     static const float deadZone = 0.20f;
 
@@ -698,37 +5667,58 @@ void HandleGamepadStickEvent(ImGuiIO* io, GamepadAxis axis, ImGuiKey negKey, ImG
 
     ImGuiIO_AddKeyAnalogEvent(io, negKey, axisValue < -deadZone, axisValue < -deadZone ? -axisValue : 0);
     ImGuiIO_AddKeyAnalogEvent(io, posKey, axisValue > deadZone, axisValue > deadZone ? axisValue : 0);
+
+    // a held stick keeps navigating
+    return axisValue < -deadZone || axisValue > deadZone;
 }
 
 bool ImGui_ImplRaylib_ProcessEvents(void)
 {
     ImGuiIO* io = igGetIO();
 
+    // true when anything was sent to ImGui this frame
+    bool hadEvents = false;
+
     bool focused = IsWindowFocused();
-    if (focused != LastFrameFocused)
+    if (focused != CurrentContext->LastFrameFocused)
+    {
         ImGuiIO_AddFocusEvent(io, focused);
-    LastFrameFocused = focused;
+        hadEvents = true;
+    }
+    CurrentContext->LastFrameFocused = focused;
 
     // handle the modifyer key events so that shortcuts work
     bool ctrlDown = rlImGuiIsControlDown();
-    if (ctrlDown != LastControlPressed)
+    if (ctrlDown != CurrentContext->LastControlPressed)
+    {
         ImGuiIO_AddKeyEvent(io, ImGuiMod_Ctrl, ctrlDown);
-    LastControlPressed = ctrlDown;
+        hadEvents = true;
+    }
+    CurrentContext->LastControlPressed = ctrlDown;
 
     bool shiftDown = rlImGuiIsShiftDown();
-    if (shiftDown != LastShiftPressed)
+    if (shiftDown != CurrentContext->LastShiftPressed)
+    {
         ImGuiIO_AddKeyEvent(io, ImGuiMod_Shift, shiftDown);
-    LastShiftPressed = shiftDown;
+        hadEvents = true;
+    }
+    CurrentContext->LastShiftPressed = shiftDown;
 
     bool altDown = rlImGuiIsAltDown();
-    if (altDown != LastAltPressed)
+    if (altDown != CurrentContext->LastAltPressed)
+    {
         ImGuiIO_AddKeyEvent(io, ImGuiMod_Alt, altDown);
-    LastAltPressed = altDown;
+        hadEvents = true;
+    }
+    CurrentContext->LastAltPressed = altDown;
 
     bool superDown = rlImGuiIsSuperDown();
-    if (superDown != LastSuperPressed)
+    if (superDown != CurrentContext->LastSuperPressed)
+    {
         ImGuiIO_AddKeyEvent(io, ImGuiMod_Super, superDown);
-    LastSuperPressed = superDown;
+        hadEvents = true;
+    }
+    CurrentContext->LastSuperPressed = superDown;
 
     // walk the keymap and check for up and down events
     enum { KeyCount = sizeof(RaylibKeyMap) / sizeof(RaylibKeyMap[0]) };
@@ -736,9 +5726,15 @@ bool ImGui_ImplRaylib_ProcessEvents(void)
     {
         const KeyPairing key_pair = RaylibKeyMap[i];
         if (IsKeyReleased(key_pair.RaylibKey))
+        {
             ImGuiIO_AddKeyEvent(io, key_pair.ImGuiKey, false);
+            hadEvents = true;
+        }
         else if(IsKeyPressed(key_pair.RaylibKey))
+        {
             ImGuiIO_AddKeyEvent(io, key_pair.ImGuiKey, true);
+            hadEvents = true;
+        }
     }
 
     if (io->WantCaptureKeyboard)
@@ -748,22 +5744,36 @@ bool ImGui_ImplRaylib_ProcessEvents(void)
         while (pressed != 0)
         {
             ImGuiIO_AddInputCharacter(io, pressed);
+            hadEvents = true;
             pressed = GetCharPressed();
         }
     }
 
     if (!io->WantSetMousePos)
     {
-        ImGuiIO_AddMousePosEvent(io, (float)GetMouseX(), (float)GetMouseY());
+        float mouseX = (float)GetMouseX();
+        float mouseY = (float)GetMouseY();
+        if (mouseX != CurrentContext->LastMousePos.x || mouseY != CurrentContext->LastMousePos.y)
+        {
+            ImGuiIO_AddMousePosEvent(io, mouseX, mouseY);
+            CurrentContext->LastMousePos = (ImVec2){ mouseX, mouseY };
+            hadEvents = true;
+        }
     }
 
     #define setMouseEvent(rayMouse, imGuiMouse)                     \
         do                                                          \
         {                                                           \
             if (IsMouseButtonPressed(rayMouse))                     \
+            {                                                       \
                 ImGuiIO_AddMouseButtonEvent(io, imGuiMouse, true);  \
+                hadEvents = true;                                   \
+            }                                                       \
             else if (IsMouseButtonReleased(rayMouse))               \
+            {                                                       \
                 ImGuiIO_AddMouseButtonEvent(io, imGuiMouse, false); \
+                hadEvents = true;                                   \
+            }                                                       \
         } while (0)
 
     setMouseEvent(MOUSE_BUTTON_LEFT, ImGuiMouseButton_Left);
@@ -774,39 +5784,43 @@ bool ImGui_ImplRaylib_ProcessEvents(void)
 
     {
         Vector2 mouseWheel = GetMouseWheelMoveV();
-        ImGuiIO_AddMouseWheelEvent(io, mouseWheel.x, mouseWheel.y);
+        if (mouseWheel.x != 0 || mouseWheel.y != 0)
+        {
+            ImGuiIO_AddMouseWheelEvent(io, mouseWheel.x, mouseWheel.y);
+            hadEvents = true;
+        }
     }
 
     if (io->ConfigFlags & ImGuiConfigFlags_NavEnableGamepad && IsGamepadAvailable(0))
     {
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_UP, ImGuiKey_GamepadDpadUp);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_RIGHT, ImGuiKey_GamepadDpadRight);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_DOWN, ImGuiKey_GamepadDpadDown);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_LEFT, ImGuiKey_GamepadDpadLeft);
-
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_UP, ImGuiKey_GamepadFaceUp);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, ImGuiKey_GamepadFaceLeft);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, ImGuiKey_GamepadFaceDown);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_LEFT, ImGuiKey_GamepadFaceRight);
-
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_TRIGGER_1, ImGuiKey_GamepadL1);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_TRIGGER_2, ImGuiKey_GamepadL2);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_TRIGGER_1, ImGuiKey_GamepadR1);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_TRIGGER_2, ImGuiKey_GamepadR2);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_THUMB, ImGuiKey_GamepadL3);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_THUMB, ImGuiKey_GamepadR3);
-
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_MIDDLE_LEFT, ImGuiKey_GamepadStart);
-        HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_MIDDLE_RIGHT, ImGuiKey_GamepadBack);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_UP, ImGuiKey_GamepadDpadUp);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_RIGHT, ImGuiKey_GamepadDpadRight);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_DOWN, ImGuiKey_GamepadDpadDown);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_FACE_LEFT, ImGuiKey_GamepadDpadLeft);
+
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_UP, ImGuiKey_GamepadFaceUp);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_RIGHT, ImGuiKey_GamepadFaceLeft);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_DOWN, ImGuiKey_GamepadFaceDown);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_FACE_LEFT, ImGuiKey_GamepadFaceRight);
+
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_TRIGGER_1, ImGuiKey_GamepadL1);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_TRIGGER_2, ImGuiKey_GamepadL2);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_TRIGGER_1, ImGuiKey_GamepadR1);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_TRIGGER_2, ImGuiKey_GamepadR2);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_LEFT_THUMB, ImGuiKey_GamepadL3);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_RIGHT_THUMB, ImGuiKey_GamepadR3);
+
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_MIDDLE_LEFT, ImGuiKey_GamepadStart);
+        hadEvents |= HandleGamepadButtonEvent(io, GAMEPAD_BUTTON_MIDDLE_RIGHT, ImGuiKey_GamepadBack);
 
         // left stick
-        HandleGamepadStickEvent(io, GAMEPAD_AXIS_LEFT_X, ImGuiKey_GamepadLStickLeft, ImGuiKey_GamepadLStickRight);
-        HandleGamepadStickEvent(io, GAMEPAD_AXIS_LEFT_Y, ImGuiKey_GamepadLStickUp, ImGuiKey_GamepadLStickDown);
+        hadEvents |= HandleGamepadStickEvent(io, GAMEPAD_AXIS_LEFT_X, ImGuiKey_GamepadLStickLeft, ImGuiKey_GamepadLStickRight);
+        hadEvents |= HandleGamepadStickEvent(io, GAMEPAD_AXIS_LEFT_Y, ImGuiKey_GamepadLStickUp, ImGuiKey_GamepadLStickDown);
 
         // right stick
-        HandleGamepadStickEvent(io, GAMEPAD_AXIS_RIGHT_X, ImGuiKey_GamepadRStickLeft, ImGuiKey_GamepadRStickRight);
-        HandleGamepadStickEvent(io, GAMEPAD_AXIS_RIGHT_Y, ImGuiKey_GamepadRStickUp, ImGuiKey_GamepadRStickDown);
+        hadEvents |= HandleGamepadStickEvent(io, GAMEPAD_AXIS_RIGHT_X, ImGuiKey_GamepadRStickLeft, ImGuiKey_GamepadRStickRight);
+        hadEvents |= HandleGamepadStickEvent(io, GAMEPAD_AXIS_RIGHT_Y, ImGuiKey_GamepadRStickUp, ImGuiKey_GamepadRStickDown);
     }
 
-    return true;
+    return hadEvents;
 }
\ No newline at end of file
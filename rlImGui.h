@@ -66,6 +66,46 @@ extern "C" {
 #endif
 
 typedef struct ImGuiContext ImGuiContext;
+typedef struct ImFontAtlas ImFontAtlas;
+typedef struct ImFont ImFont;
+typedef struct ImFontConfig ImFontConfig;
+
+// Adds fonts to an atlas built by rlImGuiReloadFontsAsync. Runs on a worker thread, so it should only use the atlas and the file system
+typedef void (*rlImGuiFontAtlasSetup)(ImFontAtlas* atlas, void* userData);
+
+// Backend state for one ImGui context, see rlImGuiCreateContext
+typedef struct rlImGuiContext rlImGuiContext;
+
+// Ways the backend can submit ImGui geometry to raylib
+typedef enum
+{
+    RLIMGUI_RENDER_IMMEDIATE = 0,   // Every triangle goes through the rlgl immediate mode batch (default, works with every OpenGL version)
+    RLIMGUI_RENDER_RETAINED,        // Draw lists are uploaded as is to GPU vertex/index buffers and drawn with one indexed draw per command (needs vertex array support)
+    RLIMGUI_RENDER_STREAMED,        // Vertices are de-indexed by a SIMD kernel into position/texcoord/color streams and drawn without indices (needs vertex array support)
+} rlImGuiRenderMode;
+
+// Counters for the last frame submitted by ImGui_ImplRaylib_RenderDrawData
+typedef struct rlImGuiRenderStats
+{
+    int DrawLists;          // Number of ImDrawLists in the frame
+    int Vertices;           // Total ImGui vertices in the frame
+    int Indices;            // Total ImGui indices in the frame
+    int Commands;           // ImGui draw commands, one submission each before merging
+    int Submissions;        // GPU submissions after adjacent commands with the same texture and clip rect were merged
+    int CulledCommands;     // Commands skipped because their clip rect was empty or outside the display
+    int StateChangesApplied;    // Scissor, texture, blend and culling changes sent to rlgl
+    int StateChangesSkipped;    // State changes dropped because the state was already set
+    int BatchCapacity;      // Vertex capacity of the dedicated rlgl batch used by the immediate path
+    int BatchHighWater;     // Largest number of batch vertices any frame has needed so far
+    int FrameCacheHit;      // 1 when the frame was composited from the frame cache instead of being rendered
+    int WindowLayersDrawn;  // Number of draw lists that were composited from a window layer
+    int WindowLayersUpdated;    // Number of window layers that had to be rendered again this frame
+    int FrameLatency;       // Frames between building the UI and drawing it, see rlImGuiSetFrameLatency
+    float BuildMilliseconds;    // Time from the start of the last built ImGui frame until rlImGuiEnd finished with it
+    float RenderMilliseconds;   // Time spent submitting the frame to raylib
+    float ResolutionScale;  // Fraction of the framebuffer resolution the frame was rasterized at, see rlImGuiSetResolutionScale
+    int TextureUploads;     // Texture regions created or updated for ImGui this frame (Dear ImGui 1.92 dynamic textures)
+} rlImGuiRenderStats;
 
 // High level API. This API is designed in the style of raylib and meant to work with reaylib code.
 // It will manage it's own ImGui context and call common ImGui functions (like NewFrame and Render) for you
@@ -103,6 +143,16 @@ RLIMGUIAPI void rlImGuiBegin(void);
 /// </summary>
 RLIMGUIAPI void rlImGuiEnd(void);
 
+/// <summary>
+/// Ends an ImGui frame and draws it into a render texture instead of the current raylib target.
+/// ImGui coordinates map 1:1 to texture pixels, anything outside of the texture is clipped.
+/// The texture ends up with premultiplied alpha, draw it with BLEND_ALPHA_PREMULTIPLY when it was cleared.
+/// The frame latency setting does not apply, the frame is drawn right away.
+/// </summary>
+/// <param name="target">The render texture to draw to</param>
+/// <param name="clear">When true the texture is cleared to transparent first</param>
+RLIMGUIAPI void rlImGuiEndToTexture(const RenderTexture* target, bool clear);
+
 /// <summary>
 /// Cleanup ImGui and unload font atlas
 /// Calls ImGui_ImplRaylib_Shutdown
@@ -130,6 +180,115 @@ RLIMGUIAPI void rlImGuiEndInitImGui(void);
 /// </summary>
 RLIMGUIAPI void rlImGuiReloadFonts(void);
 
+/// <summary>
+/// Builds a new font atlas on a worker thread while the current one stays in use. When the build is done, the next rlImGuiBegin or
+/// rlImGuiBeginIfNeeded uploads the texture and swaps the new fonts into io.Fonts. io.FontDefault is moved to the font at the same
+/// position in the new atlas. The old atlas is freed one frame later. Not available while the atlas is shared with other contexts,
+/// use rlImGuiReloadFonts for them. Contexts that start their frames with rlImGuiBeginContext don't pick up the new atlas either.
+/// </summary>
+/// <param name="setup">Adds the fonts to the new atlas, NULL adds the default font and Font Awesome like rlImGuiSetup</param>
+/// <param name="userData">Passed to the setup function</param>
+/// <returns>False if a build for the current context is still pending, or the atlas is shared with other contexts</returns>
+RLIMGUIAPI bool rlImGuiReloadFontsAsync(rlImGuiFontAtlasSetup setup, void* userData);
+
+/// <summary>
+/// Gets if a font atlas is being built, one started with rlImGuiReloadFontsAsync or one for a new display scale
+/// </summary>
+/// <returns>True while the build is running, a finished build is swapped in at the next frame</returns>
+RLIMGUIAPI bool rlImGuiIsFontBuildPending(void);
+
+/// <summary>
+/// Enables the on disk font atlas cache. When the fonts are built, a hash of the font data and every ImFontConfig setting is used to look
+/// for a file with the baked atlas in the directory. If there is one it is loaded instead of rasterizing the fonts, otherwise the atlas is
+/// built and saved there. Call before rlImGuiSetup, or before rlImGuiReloadFonts for fonts added later. The directory must exist.
+/// </summary>
+/// <param name="path">The directory for cache files, NULL to disable the cache (default)</param>
+RLIMGUIAPI void rlImGuiSetFontCacheDirectory(const char* path);
+
+/// <summary>
+/// Adds a font file to the atlas of the current context without reading it into memory. The file is mapped and shared by every size
+/// and context it is added to, and ImGui is given the mapping with FontDataOwnedByAtlas = false, so the atlases don't keep copies.
+/// The OS only loads the parts of the file that are read while the glyphs are rasterized. Call from the main thread, before
+/// rlImGuiEndInitImGui or before rlImGuiReloadFonts. Platforms that can't map files read each file once instead.
+/// </summary>
+/// <param name="fileName">The TTF/OTF file to add</param>
+/// <param name="size">The size of the font in pixels</param>
+/// <param name="config">The font settings, NULL for the defaults. FontData, FontDataSize, FontDataOwnedByAtlas and SizePixels are set by rlImGui</param>
+/// <returns>The font, NULL if the file could not be opened</returns>
+RLIMGUIAPI ImFont* rlImGuiAddFontFile(const char* fileName, float size, const ImFontConfig* config);
+
+/// <summary>
+/// Unmaps the font files added with rlImGuiAddFontFile. Files still used by the atlas of a context, including atlases kept for other
+/// display scales and builds in progress, stay mapped. Call again after the contexts using them are shut down.
+/// </summary>
+/// <returns>True if every file was unmapped, false if some are still in use</returns>
+RLIMGUIAPI bool rlImGuiUnloadFontFiles(void);
+
+/// <summary>
+/// Only loads the given Font Awesome icons instead of the whole icon range, so fewer glyphs are rasterized and the atlas is smaller.
+/// Codepoints can be in any order, duplicates are ignored. premake5 --fa-subset writes the list of icons used by the application
+/// to extras/FontAwesomeSubset.h and makes it the default. Only call before rlImGuiSetup, fonts that are already added keep their icons.
+/// </summary>
+/// <param name="codepoints">The icon codepoints (the U+ values in IconsFontAwesome6.h), NULL to load every icon (default)</param>
+/// <param name="count">The number of codepoints</param>
+RLIMGUIAPI void rlImGuiSetFontAwesomeCodepoints(const int* codepoints, int count);
+
+/// <summary>
+/// Records the codepoint of every glyph drawn with the font atlas, to find which part of large glyph ranges an application really uses.
+/// Enabling starts a new recording, disabling keeps what was recorded for rlImGuiSaveGlyphProfile. ASCII, tab and the fallback and
+/// ellipsis characters ImGui uses are always part of a profile.
+/// Looks up each vertex drawn with the font texture, so it is meant for profiling runs. Does nothing with the ImGui 1.92 dynamic atlas,
+/// which only rasterizes the glyphs that are used.
+/// </summary>
+/// <param name="enabled">true to record the glyphs drawn from now on, false to stop (default)</param>
+RLIMGUIAPI void rlImGuiSetGlyphProfiling(bool enabled);
+
+/// <summary>
+/// Writes the recorded codepoints as a compact table of ImWchar ranges, one "first, last," pair per line with a 0 terminator. The file
+/// can be loaded with rlImGuiLoadGlyphProfile, or included in C as the initializer of an array passed to ImFontConfig.GlyphRanges.
+/// </summary>
+/// <param name="fileName">The file to write</param>
+/// <returns>True if the file was written</returns>
+RLIMGUIAPI bool rlImGuiSaveGlyphProfile(const char* fileName);
+
+/// <summary>
+/// Builds the fonts from a glyph profile: the glyph ranges of each font are limited to the codepoints in the profile while the atlas is
+/// built, the fonts keep their own ranges. A font that has none of the codepoints is built with its full ranges, unless it is merged
+/// into another one. Applies to the atlases built afterwards, call before rlImGuiSetup or before rlImGuiReloadFonts.
+/// </summary>
+/// <param name="fileName">A file written by rlImGuiSaveGlyphProfile, NULL to build the full ranges again (default)</param>
+/// <returns>True if the profile was loaded</returns>
+RLIMGUIAPI bool rlImGuiLoadGlyphProfile(const char* fileName);
+
+/// <summary>
+/// Rasterizes the fonts of the current context at the DPI scale of the monitor the window is on, and keeps the atlases of scales
+/// used before. When the scale changes the atlas for it is swapped in right away, or built on a worker thread the first time while
+/// the current fonts stay in use. Unused atlases are freed least recently used first, see RLIMGUI_SCALED_FONT_ATLAS_MEMORY.
+/// Fonts keep their ImFont objects across swaps, the same position in io.Fonts gets the glyphs of the new scale. Not used by contexts
+/// with a shared atlas.
+/// </summary>
+/// <param name="enabled">true to keep an atlas per display scale, false to keep the current fonts at any scale (default)</param>
+RLIMGUIAPI void rlImGuiSetDPIFontAtlases(bool enabled);
+
+/// <summary>
+/// Loads a font as signed distance fields, drawn by a shader that keeps the glyphs sharp at any size. One set of glyphs serves every
+/// size: push the font and scale it (igSetWindowFontScale) or pass a size to ImDrawList_AddText. Each SDF font has its own texture.
+/// Needs shader support with derivatives: returns NULL on OpenGL 1.1, on OpenGL ES 2.0 without GL_OES_standard_derivatives, with the
+/// ImGui 1.92 dynamic atlas and when RLIMGUI_MAX_SDF_FONTS fonts are already loaded.
+/// </summary>
+/// <param name="fileName">The TTF/OTF file to load</param>
+/// <param name="fontSize">The size the distance fields are rendered at, and the size of the font when it is not scaled</param>
+/// <param name="codepoints">The characters to load, NULL for the 95 ASCII characters</param>
+/// <param name="codepointCount">The number of codepoints</param>
+/// <returns>The font, NULL if it could not be loaded</returns>
+RLIMGUIAPI ImFont* rlImGuiLoadSDFFont(const char* fileName, float fontSize, const int* codepoints, int codepointCount);
+
+/// <summary>
+/// Frees a font loaded with rlImGuiLoadSDFFont and its texture
+/// </summary>
+/// <param name="font">The font to free</param>
+RLIMGUIAPI void rlImGuiUnloadSDFFont(ImFont* font);
+
 // Advanced Update API
 
 /// <summary>
@@ -138,6 +297,213 @@ RLIMGUIAPI void rlImGuiReloadFonts(void);
 /// <param name="dt">delta time, any value < 0 will use raylib GetFrameTime</param>
 RLIMGUIAPI void rlImGuiBeginDelta(float deltaTime);
 
+/// <summary>
+/// Starts a new ImGui frame only when the UI needs one: after input events, while ImGui is still reacting to input
+/// (active items, text input, held mouse buttons), for RLIMGUI_IDLE_GRACE_TIME seconds after that, on window resize,
+/// or after rlImGuiRequestRedraw. When it returns false skip your ImGui code, rlImGuiEnd will draw the last frame again.
+/// Always call rlImGuiEnd after this function.
+/// </summary>
+/// <returns>True if a new ImGui frame was started</returns>
+RLIMGUIAPI bool rlImGuiBeginIfNeeded(void);
+
+/// <summary>
+/// Sets how often rlImGuiBeginIfNeeded builds a new ImGui frame when there is no input, so the UI can tick slower than the game.
+/// Input still starts a frame right away. On the frames in between rlImGuiEnd draws a copy of the last built frame.
+/// </summary>
+/// <param name="seconds">time between UI frames, 0 to use the idle behavior described in rlImGuiBeginIfNeeded</param>
+RLIMGUIAPI void rlImGuiSetUpdateInterval(float seconds);
+
+/// <summary>
+/// Sets the number of frames between building the UI and drawing it. With 0 rlImGuiEnd draws the frame right away.
+/// With 1 rlImGuiEnd only keeps a copy of the draw data, which is drawn at the start of the next rlImGuiBegin
+/// (or by rlImGuiRenderPendingFrame), so the GPU submission of one frame happens before the UI code of the next one runs.
+/// The UI is shown one frame late.
+/// </summary>
+/// <param name="frames">0 or 1</param>
+RLIMGUIAPI void rlImGuiSetFrameLatency(int frames);
+
+/// <summary>
+/// Draws the frame kept by rlImGuiEnd when the frame latency is 1, use this to draw the UI at a specific point in your frame.
+/// Does nothing if there is no pending frame.
+/// </summary>
+RLIMGUIAPI void rlImGuiRenderPendingFrame(void);
+
+/// <summary>
+/// Makes the next call to rlImGuiBeginIfNeeded start a new frame, use when data shown in the UI changed without input
+/// </summary>
+RLIMGUIAPI void rlImGuiRequestRedraw(void);
+
+/// <summary>
+/// When enabled, rlImGuiBeginIfNeeded puts raylib into event waiting while the UI is idle, so EndDrawing blocks until the next input event.
+/// Only use this when nothing else in the application needs to animate while the UI is idle.
+/// </summary>
+/// <param name="enabled">When true raylib waits for events while ImGui is idle</param>
+RLIMGUIAPI void rlImGuiSetIdleEventWaiting(bool enabled);
+
+// Advanced Render API
+
+/// <summary>
+/// Selects how ImGui geometry is submitted to raylib. Applies to rlImGuiEnd and ImGui_ImplRaylib_RenderDrawData
+/// The retained mode is much cheaper on the CPU for large UIs, it falls back to immediate mode when the OpenGL version does not support vertex arrays
+/// </summary>
+/// <param name="mode">The render mode to use</param>
+RLIMGUIAPI void rlImGuiSetRenderMode(rlImGuiRenderMode mode);
+
+/// <summary>
+/// Gets the current render mode
+/// </summary>
+/// <returns>The render mode set with rlImGuiSetRenderMode</returns>
+RLIMGUIAPI rlImGuiRenderMode rlImGuiGetRenderMode(void);
+
+/// <summary>
+/// Gets the counters for the last rendered ImGui frame
+/// </summary>
+/// <returns>The render stats of the last call to rlImGuiEnd or ImGui_ImplRaylib_RenderDrawData</returns>
+RLIMGUIAPI rlImGuiRenderStats rlImGuiGetRenderStats(void);
+
+/// <summary>
+/// Enables whole frame output caching. The draw data is hashed every frame (vertices, indices, commands and texture IDs),
+/// when nothing changed the UI is drawn from a render texture holding the previous output instead of submitting the geometry again.
+/// Frames with user callbacks are always rendered. The cached frame is composited to the screen framebuffer.
+/// </summary>
+/// <param name="enabled">When true the frame cache is used</param>
+RLIMGUIAPI void rlImGuiSetFrameCaching(bool enabled);
+
+/// <summary>
+/// Forces the next frame to be rendered even if the draw data did not change.
+/// Call this when the contents of a texture shown in ImGui changed (such as a render texture with a game view)
+/// </summary>
+RLIMGUIAPI void rlImGuiInvalidateFrameCache(void);
+
+/// <summary>
+/// Gets the fraction of frames that were drawn from the frame cache since it was enabled
+/// </summary>
+/// <returns>The hit rate between 0 and 1</returns>
+RLIMGUIAPI float rlImGuiGetFrameCacheHitRate(void);
+
+/// <summary>
+/// Enables per window layers. Draw lists with many vertices that stop changing are rendered once into their own render texture,
+/// and composited from that texture until their content changes again. Windows that change every frame are drawn as usual.
+/// rlImGuiInvalidateFrameCache also invalidates the layers. When frame caching is enabled it takes precedence over layers.
+/// </summary>
+/// <param name="enabled">When true window layers are used</param>
+RLIMGUIAPI void rlImGuiSetWindowLayers(bool enabled);
+
+/// <summary>
+/// Renders the UI of the current context at a fraction of the framebuffer resolution into an offscreen target, which is then stretched over the display.
+/// This lowers the fill rate cost of large UIs on slow GPUs. Layout, input and clip rects stay in display coordinates, only the rasterization is scaled.
+/// Can be changed every frame, for example from the render stats, to stay within a frame time budget. Does not apply when drawing to a render texture.
+/// When the frame cache is enabled the cached frame is kept at the scaled resolution, window layers are not used while the scale is below 1.
+/// </summary>
+/// <param name="scale">Fraction of the resolution between 0.25 and 1, 1 (default) draws straight to the target</param>
+RLIMGUIAPI void rlImGuiSetResolutionScale(float scale);
+
+/// <summary>
+/// Gets the resolution scale of the current context
+/// </summary>
+/// <returns>The scale set with rlImGuiSetResolutionScale</returns>
+RLIMGUIAPI float rlImGuiGetResolutionScale(void);
+
+/// <summary>
+/// Sets the strength of the sharpening filter applied when a scaled UI is stretched over the display. Needs shader support (not OpenGL 1.1)
+/// </summary>
+/// <param name="amount">0 (default) for plain bilinear filtering, around 0.5 to restore most of the text contrast</param>
+RLIMGUIAPI void rlImGuiSetResolutionSharpening(float amount);
+
+/// <summary>
+/// Gets the name of the vertex kernel used by the streamed render mode, picked at runtime from the CPU features
+/// </summary>
+/// <returns>"AVX2", "SSE2", "NEON" or "scalar"</returns>
+RLIMGUIAPI const char* rlImGuiGetStreamKernelName(void);
+
+// Multiple context API
+// Every context has its own ImGui context, fonts, input state, display size and render target.
+// The functions above work on the current context of the calling thread, which is the one created by rlImGuiSetup by default.
+
+/// <summary>
+/// Creates an additional context, with its own ImGui context, fonts and theme. Must be called on the thread that owns the OpenGL context
+/// </summary>
+/// <param name="darkTheme">when true the dark theme is used, when false the light theme is used</param>
+/// <returns>The new context</returns>
+RLIMGUIAPI rlImGuiContext* rlImGuiCreateContext(bool darkTheme);
+
+/// <summary>
+/// When enabled, contexts created after this call (including by rlImGuiSetup) use one shared ImFontAtlas and one font texture,
+/// instead of building and uploading their own. The atlas is reference counted and freed with the last context using it.
+/// rlImGuiReloadFonts on any of these contexts rebuilds the shared texture once for all of them.
+/// Don't change the shared atlas while another context is between begin and end.
+/// </summary>
+/// <param name="enabled">When true new contexts share one font atlas</param>
+RLIMGUIAPI void rlImGuiSetSharedFontAtlas(bool enabled);
+
+/// <summary>
+/// Shuts down and frees a context created with rlImGuiCreateContext. Must be called on the thread that owns the OpenGL context
+/// </summary>
+/// <param name="context">The context to destroy</param>
+RLIMGUIAPI void rlImGuiDestroyContext(rlImGuiContext* context);
+
+/// <summary>
+/// Sets the context used by the rlImGui functions on the calling thread, and makes its ImGui context current
+/// </summary>
+/// <param name="context">The context to use, NULL for the default context</param>
+RLIMGUIAPI void rlImGuiSetCurrentContext(rlImGuiContext* context);
+
+/// <summary>
+/// Gets the context used by the rlImGui functions on the calling thread
+/// </summary>
+/// <returns>The current context</returns>
+RLIMGUIAPI rlImGuiContext* rlImGuiGetCurrentContext(void);
+
+/// <summary>
+/// Sets if a context gets raylib input events and changes the mouse cursor. Contexts built on worker threads should turn this off
+/// and get their input from the application.
+/// </summary>
+/// <param name="context">The context, NULL for the current context</param>
+/// <param name="receivesInput">When true raylib input is sent to the context</param>
+RLIMGUIAPI void rlImGuiSetContextInput(rlImGuiContext* context, bool receivesInput);
+
+/// <summary>
+/// Sets the size of the UI of a context in pixels, instead of using the size of the raylib window
+/// </summary>
+/// <param name="context">The context, NULL for the current context</param>
+/// <param name="width">Width of the UI, 0 to use the window size</param>
+/// <param name="height">Height of the UI, 0 to use the window size</param>
+RLIMGUIAPI void rlImGuiSetContextDisplaySize(rlImGuiContext* context, float width, float height);
+
+/// <summary>
+/// Makes rlImGuiRenderContext draw a context into a render texture. The UI uses the size of the texture unless a display size is set.
+/// </summary>
+/// <param name="context">The context, NULL for the current context</param>
+/// <param name="target">The render texture to draw to, NULL to draw to the current raylib target</param>
+RLIMGUIAPI void rlImGuiSetContextRenderTarget(rlImGuiContext* context, const RenderTexture* target);
+
+/// <summary>
+/// Makes a context current on the calling thread and starts a new ImGui frame for it.
+/// This does not use OpenGL or the raylib window, so different contexts can be built on different threads at the same time
+/// as long as ImGui is compiled with a thread local current context (see GImGui in imgui.cpp). The window size, DPI scale and
+/// frame time are the ones rlImGuiRenderContext sampled on the main thread. Contexts built on a worker thread must not receive
+/// input (rlImGuiSetContextInput), raylib's input state and mouse cursor belong to the main thread. Functions that upload
+/// textures, like rlImGuiIcon, rlImGuiLoadSDFFont and the font reload functions, are main thread only.
+/// </summary>
+/// <param name="context">The context to start a frame for</param>
+RLIMGUIAPI void rlImGuiBeginContext(rlImGuiContext* context);
+
+/// <summary>
+/// Ends the frame of a context and keeps a copy of its draw data for rlImGuiRenderContext. Does not use OpenGL.
+/// The copies are triple buffered, so rlImGuiRenderContext can draw the previous frame while the next one is ended.
+/// With dynamic textures the texture requests of the frame are copied too, and applied by rlImGuiRenderContext before it draws the frame.
+/// </summary>
+/// <param name="context">The context to end the frame for</param>
+RLIMGUIAPI void rlImGuiEndContext(rlImGuiContext* context);
+
+/// <summary>
+/// Draws the last frame ended with rlImGuiEndContext to the render target of the context, or to the current raylib target.
+/// Must be called on the thread that owns the OpenGL context and the raylib window, it also samples the window state the next
+/// rlImGuiBeginContext of the context uses
+/// </summary>
+/// <param name="context">The context to draw, NULL for the current context</param>
+RLIMGUIAPI void rlImGuiRenderContext(rlImGuiContext* context);
+
 // ImGui Image API extensions
 // Purely for convenience in working with raylib textures as images.
 // If you want to call ImGui image functions directly, simply pass them the pointer to the texture.
@@ -193,6 +559,23 @@ RLIMGUIAPI void rlImGuiImageRenderTexture(const RenderTexture* image);
 /// <param name="center">When true the image will be centered in the content area</param>
 RLIMGUIAPI void rlImGuiImageRenderTextureFit(const RenderTexture* image, bool center);
 
+/// <summary>
+/// Draws a Font Awesome icon at any size in an ImGui context, using the current text color. Icons are rasterized the first time they are
+/// used at a size, into textures of their own instead of the font atlas, so large icons don't need an icon font merged at that size.
+/// Pages are added as icons are used, up to RLIMGUI_MAX_ICON_PAGES, then the least recently used page is cleared.
+/// </summary>
+/// <param name="icon">The icon, one of the ICON_FA_ strings from IconsFontAwesome6.h</param>
+/// <param name="size">The height of the icon</param>
+RLIMGUIAPI void rlImGuiIcon(const char* icon, float size);
+
+/// <summary>
+/// Draws a Font Awesome icon at any size in an ImGui context, with a color
+/// </summary>
+/// <param name="icon">The icon, one of the ICON_FA_ strings from IconsFontAwesome6.h</param>
+/// <param name="size">The height of the icon</param>
+/// <param name="color">The color of the icon</param>
+RLIMGUIAPI void rlImGuiIconColored(const char* icon, float size, Color color);
+
 /// <summary>
 /// Draws a texture as an image button in an ImGui context. Uses the current ImGui cursor position and the full size of the texture
 /// </summary>